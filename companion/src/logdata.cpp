@@ -0,0 +1,527 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logdata.h"
+#include "radio/src/logs_binary.h"
+
+#include <ctype.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// below this number of records per thread, the columns are not parsed
+// in parallel
+#define MIN_CHUNK_RECORDS   4096
+
+// Runs function(begin, end) on chunks of [0, count[, using all the cores
+template <class Function>
+static void parallelChunks(int count, Function function)
+{
+  int threads = qBound(1, QThread::idealThreadCount(),
+                       (count + MIN_CHUNK_RECORDS - 1) / MIN_CHUNK_RECORDS);
+  int chunk = (count + threads - 1) / threads;
+
+  std::vector<std::thread> workers;
+  for (int begin = chunk; begin < count; begin += chunk) {
+    workers.emplace_back(function, begin, qMin(begin + chunk, count));
+  }
+  function(0, qMin(chunk, count));
+  for (auto & worker : workers) {
+    worker.join();
+  }
+}
+
+static const double powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+                                     1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+// Parses a number as QString::toDouble() does, returns 0 if invalid.
+// The plain decimals written by the radio are parsed without any copy
+// (exact result, as both the mantissa and the divisor are exact).
+static double parseNumber(const QByteArray & text)
+{
+  const char * p = text.constData();
+  const char * end = p + text.size();
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = (*p++ == '-');
+  }
+
+  qint64 mantissa = 0;
+  int digits = 0, decimals = -1;
+  for (; p < end; p++) {
+    if (*p >= '0' && *p <= '9') {
+      mantissa = mantissa * 10 + (*p - '0');
+      digits++;
+      if (decimals >= 0) decimals++;
+    }
+    else if (*p == '.' && decimals < 0) {
+      decimals = 0;
+    }
+    else {
+      break;
+    }
+  }
+
+  if (p == end && digits > 0 && digits <= 15) {
+    double value = mantissa / powersOf10[qMax(decimals, 0)];
+    return negative ? -value : value;
+  }
+
+  bool ok;
+  double value = text.toDouble(&ok);
+  return ok ? value : 0;
+}
+
+static bool parseDigits(const char * p, int count, int & value)
+{
+  value = 0;
+  for (int i = 0; i < count; i++) {
+    if (p[i] < '0' || p[i] > '9') return false;
+    value = value * 10 + (p[i] - '0');
+  }
+  return true;
+}
+
+// The last hour converted: QDateTime is only used when it changes
+struct TimeBase {
+  int year = -1;
+  int month = 0;
+  int day = 0;
+  int hour = 0;
+  qint64 secs = 0;
+};
+
+// Local time "yyyy-MM-dd" "HH:mm:ss[.zzz]" in seconds since 1970
+static double parseTimestamp(const QByteArray & date, const QByteArray & time, TimeBase & base)
+{
+  const char * d = date.constData();
+  const char * t = time.constData();
+  int year, month, day, hour, minute, second;
+
+  if (date.size() != 10 || time.size() < 8 ||
+      !parseDigits(d, 4, year) || d[4] != '-' || !parseDigits(d + 5, 2, month) ||
+      d[7] != '-' || !parseDigits(d + 8, 2, day) ||
+      !parseDigits(t, 2, hour) || t[2] != ':' || !parseDigits(t + 3, 2, minute) ||
+      t[5] != ':' || !parseDigits(t + 6, 2, second) || minute > 59 || second > 59) {
+    return qQNaN();
+  }
+
+  double fraction = 0;
+  if (time.size() > 8) {
+    int decimals = time.size() - 9;
+    int value;
+    if (t[8] != '.' || decimals < 1 || decimals > 9 || !parseDigits(t + 9, decimals, value))
+      return qQNaN();
+    fraction = value / powersOf10[decimals];
+  }
+
+  if (year != base.year || month != base.month || day != base.day || hour != base.hour) {
+    QDateTime dateTime(QDate(year, month, day), QTime(hour, 0));
+    if (!dateTime.isValid())
+      return qQNaN();
+    base.year = year;
+    base.month = month;
+    base.day = day;
+    base.hour = hour;
+    base.secs = dateTime.toSecsSinceEpoch();
+  }
+
+  return base.secs + minute * 60 + second + fraction;
+}
+
+static QByteArray binaryLogValue(qint64 value, int prec)
+{
+  if (prec == 0)
+    return QByteArray::number(value);
+  qint64 divisor = prec == 1 ? 10 : 100;
+  qint64 absValue = qAbs(value);
+  return QString("%1%2.%3").arg(value < 0 ? "-" : "")
+      .arg(absValue / divisor)
+      .arg(absValue % divisor, prec, 10, QChar('0')).toLatin1();
+}
+
+static QByteArray binaryLogGpsCoord(qint32 value)
+{
+  qint64 absValue = qAbs((qint64)value);
+  return QString("%1%2.%3").arg(value < 0 ? "-" : "")
+      .arg(absValue / 1000000)
+      .arg(absValue % 1000000, 6, 10, QChar('0')).toLatin1();
+}
+
+static quint8 u8(const char * p)
+{
+  return (quint8)p[0];
+}
+
+static quint16 u16(const char * p)
+{
+  return (quint16)(u8(p) | (u8(p + 1) << 8));
+}
+
+static quint32 u32(const char * p)
+{
+  return (quint32)(u16(p) | ((quint32)u16(p + 2) << 16));
+}
+
+LogData::LogData():
+  data(nullptr),
+  size(0),
+  count(0),
+  binaryStart(0),
+  recordSize(0)
+{
+}
+
+LogData::~LogData()
+{
+  close();
+}
+
+bool LogData::open(const QString & filename, int & errors, int & lines)
+{
+  close();
+  errors = 0;
+  lines = 0;
+
+  file.setFileName(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  size = file.size();
+  data = size > 0 ? (const char *)file.map(0, size) : nullptr;
+  if (!data) {
+    buffer = file.readAll();
+    data = buffer.constData();
+    size = buffer.size();
+  }
+
+  bool result;
+  if (size >= 4 && !memcmp(data, LOGS_BINARY_MAGIC, 4))
+    result = indexBinary(errors, lines);
+  else
+    result = indexCsv(errors, lines);
+
+  if (!result || count == 0) {
+    close();
+    return false;
+  }
+
+  return true;
+}
+
+void LogData::close()
+{
+  if (data && buffer.isEmpty()) {
+    file.unmap((uchar *)data);
+  }
+  file.close();
+  buffer.clear();
+  data = nullptr;
+  size = 0;
+  count = 0;
+  header.clear();
+  starts.clear();
+  binaryFields.clear();
+  numericColumns.clear();
+  timestamps.clear();
+}
+
+bool LogData::indexCsv(int & errors, int & lines)
+{
+  const char * end = data + size;
+  const char * eol = (const char *)memchr(data, '\n', size);
+  const char * pos = eol ? eol + 1 : end;
+
+  QByteArray first = QByteArray::fromRawData(data, (eol ? eol : end) - data).trimmed();
+  if (!first.startsWith("Date,Time")) {
+    return false;
+  }
+  header = QString::fromUtf8(first).split(',');
+
+  // only the records with the same number of fields as the header are kept
+  const int numfields = header.count();
+  while (pos < end) {
+    eol = (const char *)memchr(pos, '\n', end - pos);
+    const char * lineEnd = eol ? eol : end;
+    int fields = 1;
+    for (const char * p = pos; (p = (const char *)memchr(p, ',', lineEnd - p)); p++) {
+      fields++;
+    }
+    if (fields == numfields)
+      starts.append(pos - data);
+    else
+      errors++;
+    lines++;
+    pos = lineEnd + 1;
+  }
+
+  count = starts.size();
+  return true;
+}
+
+bool LogData::indexBinary(int & errors, int & lines)
+{
+  if (size < LOGS_BINARY_PREAMBLE_SIZE || u8(data + 4) != LOGS_BINARY_VERSION)
+    return false;
+
+  int columnsCount = u16(data + 6);
+  recordSize = u16(data + 8);
+  int headerSize = u16(data + 10);
+  if (recordSize == 0 || headerSize > size)
+    return false;
+
+  int pos = LOGS_BINARY_PREAMBLE_SIZE;
+  int offset = 0;
+  int unknownColumns = 0;
+  for (int i = 0; i < columnsCount; i++) {
+    if (pos + 3 > headerSize)
+      return false;
+    BinaryField field = { u8(data + pos), u8(data + pos + 1), u8(data + pos + 2), 0, offset };
+    pos += 3;
+    const char * name = data + pos;
+    const char * nameEnd = (const char *)memchr(name, '\0', headerSize - pos);
+    const char * unitEnd = nameEnd ? (const char *)memchr(nameEnd + 1, '\0', data + headerSize - nameEnd - 1) : nullptr;
+    if (!unitEnd)
+      return false;
+    QString unit = QString::fromLatin1(nameEnd + 1, unitEnd - nameEnd - 1);
+    pos = unitEnd + 1 - data;
+
+    if (field.type == LOGS_COLUMN_RTC) {
+      header << "Date" << "Time";
+      binaryFields.append(field);
+      field.part = 1;
+    }
+    else if (unit.isEmpty()) {
+      header << QString::fromLatin1(name, nameEnd - name);
+    }
+    else {
+      header << QString("%1(%2)").arg(QString::fromLatin1(name, nameEnd - name)).arg(unit);
+    }
+
+    if (field.type > LOGS_COLUMN_TEXT)
+      unknownColumns++;
+    binaryFields.append(field);
+    offset += field.size;
+  }
+
+  if (pos != headerSize || offset != recordSize || header.value(0) != "Date")
+    return false;
+
+  // an incomplete last record (radio switched off) is ignored
+  binaryStart = headerSize;
+  count = (size - headerSize) / recordSize;
+  lines = count;
+  errors = unknownColumns * count;
+  return true;
+}
+
+const char * LogData::record(int row, const char ** end) const
+{
+  const char * start = data + starts.at(row);
+  const char * eol = (const char *)memchr(start, '\n', data + size - start);
+  *end = eol ? eol : data + size;
+
+  while (start < *end && isspace((uchar)*start))
+    start++;
+  while (*end > start && isspace((uchar)(*end)[-1]))
+    (*end)--;
+  return start;
+}
+
+QByteArray LogData::field(int row, int column) const
+{
+  if (binaryFields.isEmpty()) {
+    const char * end;
+    const char * start = record(row, &end);
+    for (int i = 0; i < column && start < end; i++) {
+      const char * comma = (const char *)memchr(start, ',', end - start);
+      start = comma ? comma + 1 : end;
+    }
+    const char * comma = (const char *)memchr(start, ',', end - start);
+    return QByteArray::fromRawData(start, (comma ? comma : end) - start);
+  }
+
+  const BinaryField & field = binaryFields.at(column);
+  const char * p = data + binaryStart + (qint64)row * recordSize + field.offset;
+
+  switch (field.type) {
+    case LOGS_COLUMN_TIME:
+      return QByteArray::number(u32(p));
+
+    case LOGS_COLUMN_RTC: {
+      QDateTime time = QDateTime::fromSecsSinceEpoch(u32(p), Qt::UTC);
+      if (field.part == 0)
+        return time.toString("yyyy-MM-dd").toLatin1();
+      return (time.toString("HH:mm:ss") + QString(".%1").arg(u8(p + 4), 2, 10, QChar('0')) + "0").toLatin1();
+    }
+
+    case LOGS_COLUMN_VALUE: {
+      qint64 value = field.size == 1 ? (qint8)u8(p) : field.size == 2 ? (qint16)u16(p) : (qint32)u32(p);
+      return binaryLogValue(value, field.prec);
+    }
+
+    case LOGS_COLUMN_HEX: {
+      QByteArray hex = "0x";
+      for (int i = field.size - 1; i >= 0; i--)
+        hex += QByteArray::number(u8(p + i), 16).rightJustified(2, '0').toUpper();
+      return hex;
+    }
+
+    case LOGS_COLUMN_GPS: {
+      qint32 latitude = u32(p);
+      qint32 longitude = u32(p + 4);
+      if (latitude && longitude)
+        return binaryLogGpsCoord(latitude) + " " + binaryLogGpsCoord(longitude);
+      return QByteArray();
+    }
+
+    case LOGS_COLUMN_DATETIME:
+      return QString("%1-%2-%3 %4:%5:%6").arg(u16(p), 4)
+          .arg(u8(p + 2), 2, 10, QChar('0'))
+          .arg(u8(p + 3), 2, 10, QChar('0'))
+          .arg(u8(p + 4), 2, 10, QChar('0'))
+          .arg(u8(p + 5), 2, 10, QChar('0'))
+          .arg(u8(p + 6), 2, 10, QChar('0')).toLatin1();
+
+    case LOGS_COLUMN_TEXT: {
+      int length = 0;
+      while (length < field.size && p[length])
+        length++;
+      return "\"" + QByteArray(p, length) + "\"";
+    }
+
+    default:
+      return QByteArray();
+  }
+}
+
+QString LogData::cell(int row, int column) const
+{
+  return QString::fromUtf8(field(row, column));
+}
+
+QByteArray LogData::line(int row) const
+{
+  if (binaryFields.isEmpty()) {
+    const char * end;
+    const char * start = record(row, &end);
+    return QByteArray::fromRawData(start, end - start);
+  }
+
+  QByteArray result;
+  for (int column = 0; column < columns(); column++) {
+    if (column > 0) result += ',';
+    result += field(row, column);
+  }
+  return result;
+}
+
+double LogData::value(int row, int column) const
+{
+  if (!binaryFields.isEmpty()) {
+    const BinaryField & field = binaryFields.at(column);
+    const char * p = data + binaryStart + (qint64)row * recordSize + field.offset;
+    if (field.type == LOGS_COLUMN_VALUE && field.prec <= 2) {
+      qint64 value = field.size == 1 ? (qint8)u8(p) : field.size == 2 ? (qint16)u16(p) : (qint32)u32(p);
+      return value / powersOf10[field.prec];
+    }
+    if (field.type == LOGS_COLUMN_TIME) {
+      return u32(p);
+    }
+  }
+
+  return parseNumber(field(row, column));
+}
+
+QVector<double> LogData::numericColumn(int column)
+{
+  auto it = numericColumns.constFind(column);
+  if (it != numericColumns.constEnd()) {
+    return *it;
+  }
+
+  QVector<double> values(count);
+  double * result = values.data();
+  parallelChunks(count, [=](int begin, int end) {
+    for (int row = begin; row < end; row++) {
+      result[row] = value(row, column);
+    }
+  });
+
+  numericColumns.insert(column, values);
+  return values;
+}
+
+QVector<double> LogData::timeColumn()
+{
+  if (timestamps.size() != count) {
+    timestamps.resize(count);
+    double * result = timestamps.data();
+    parallelChunks(count, [=](int begin, int end) {
+      TimeBase base;
+      for (int row = begin; row < end; row++) {
+        result[row] = parseTimestamp(field(row, 0), field(row, 1), base);
+      }
+    });
+  }
+
+  return timestamps;
+}
+
+LogTableModel::LogTableModel(LogData & log, QObject * parent):
+  QAbstractTableModel(parent),
+  log(log)
+{
+}
+
+bool LogTableModel::load(const QString & filename, int & errors, int & lines)
+{
+  beginResetModel();
+  bool result = log.open(filename, errors, lines);
+  endResetModel();
+  return result;
+}
+
+int LogTableModel::rowCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : log.rows();
+}
+
+int LogTableModel::columnCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : log.columns();
+}
+
+QVariant LogTableModel::data(const QModelIndex & index, int role) const
+{
+  if (index.isValid() && role == Qt::DisplayRole) {
+    return log.cell(index.row(), index.column());
+  }
+  return QVariant();
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+    return log.getHeader().value(section);
+  }
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
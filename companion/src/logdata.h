@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <QtCore>
+#include <QAbstractTableModel>
+
+// Flight log (CSV, or binary log see radio/src/logs_binary.h) read
+// without being loaded: the file is memory mapped and only the offsets
+// of the records are kept. The cells are decoded on demand, and the
+// columns to plot are parsed once into numeric arrays.
+class LogData
+{
+  public:
+    LogData();
+    ~LogData();
+
+    // errors: number of invalid records, lines: total number of records
+    bool open(const QString & filename, int & errors, int & lines);
+    void close();
+
+    int rows() const { return count; }
+    int columns() const { return header.count(); }
+    const QStringList & getHeader() const { return header; }
+
+    // the cell text, without copy for the CSV logs
+    QByteArray field(int row, int column) const;
+    QString cell(int row, int column) const;
+    // the record as written in a CSV log
+    QByteArray line(int row) const;
+
+    // the values of a column (0 if not a number)
+    QVector<double> numericColumn(int column);
+    // the Date and Time columns in seconds since 1970 (NaN if invalid)
+    QVector<double> timeColumn();
+
+  protected:
+    struct BinaryField {
+      quint8 type;
+      quint8 size;
+      quint8 prec;
+      quint8 part;     // RTC column: 0 for the date, 1 for the time
+      int offset;      // in the record
+    };
+
+    QFile file;
+    QByteArray buffer; // used when the file can't be mapped
+    const char * data;
+    qint64 size;
+    int count;
+    QStringList header;
+
+    // CSV logs: the start of each record, the end being the next '\n'
+    QVector<qint64> starts;
+
+    // binary logs: the records have a fixed size
+    QVector<BinaryField> binaryFields;
+    qint64 binaryStart;
+    int recordSize;
+
+    QHash<int, QVector<double>> numericColumns;
+    QVector<double> timestamps;
+
+    bool indexCsv(int & errors, int & lines);
+    bool indexBinary(int & errors, int & lines);
+    double value(int row, int column) const;
+    const char * record(int row, const char ** end) const;
+};
+
+// Virtual table on a log: only the visible cells are decoded
+class LogTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+  public:
+    explicit LogTableModel(LogData & log, QObject * parent = nullptr);
+
+    bool load(const QString & filename, int & errors, int & lines);
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+  private:
+    LogData & log;
+};
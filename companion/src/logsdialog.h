@@ -23,6 +23,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "logdata.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -49,6 +50,7 @@ class LogsDialog : public QDialog
     double max_y;
     yaxes_t yaxis;
     QString name;
+    bool sorted;
   };
 
   struct minMax_t {
@@ -57,7 +59,7 @@ class LogsDialog : public QDialog
   };
 
   struct plotsCollection {
-    QVarLengthArray<coords_t> coords;
+    QVector<coords_t> coords;
     double min_x;
     double max_x;
     bool tooManyRanges;
@@ -81,9 +83,11 @@ private slots:
   void sessionsCurrentIndexChanged(int index);
   void mapsButtonClicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRange(QCPRange range);
 
 private:
-  QList<QStringList> csvlog;
+  LogData log;
+  LogTableModel * logModel;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -101,12 +105,17 @@ private:
   QCPItemTracer * cursorB;
   QCPItemStraightLine * cursorLine;
 
+  // the data of the graphs, before decimation
+  QVector<coords_t> graphsCoords;
+
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QVector<int> selectedRecords();
+  QVector<int> filterGePoints(int gpscol);
   void exportToGoogleEarth();
   QDateTime getRecordTimeStamp(int index);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
+  void setGraphData(int index);
 
   void addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph);
   void countNumberOfThrows(const coords_t & c, QCPGraph * graph);
@@ -276,6 +276,60 @@ void getSystemAudioFile(char * filename, int index)
   strcat(str, SOUNDS_EXT);
 }
 
+// Headers of the last played files: the prompts are played again and
+// again, there is no need to parse their RIFF chunks each time
+#define WAV_HEADERS_CACHE_SIZE  32
+
+struct WavHeader {
+  uint32_t hash;        // hash of the file path, 0 if unused
+  uint32_t fileSize;    // files replaced on the SD card are not used
+  uint32_t dataOffset;
+  uint32_t dataSize;
+  uint16_t freq;
+  uint8_t  codec;
+  uint8_t  age;
+};
+
+static WavHeader wavHeaders[WAV_HEADERS_CACHE_SIZE];
+static volatile bool wavHeadersReset = false;
+
+// called by the audio task only
+static WavHeader * findWavHeader(uint32_t hash, uint32_t fileSize)
+{
+  if (wavHeadersReset) {
+    wavHeadersReset = false;
+    memset(wavHeaders, 0, sizeof(wavHeaders));
+  }
+
+  WavHeader * result = nullptr;
+  for (auto & header: wavHeaders) {
+    if (header.hash == hash && header.fileSize == fileSize)
+      result = &header;
+    else if (header.age < 255)
+      header.age++;
+  }
+
+  if (result)
+    result->age = 0;
+
+  return result;
+}
+
+static void addWavHeader(const WavHeader & header)
+{
+  // replace the least recently used one
+  WavHeader * oldest = &wavHeaders[0];
+  for (auto & entry: wavHeaders) {
+    if (!entry.hash) {
+      oldest = &entry;
+      break;
+    }
+    if (entry.age > oldest->age)
+      oldest = &entry;
+  }
+  *oldest = header;
+}
+
 void referenceSystemAudioFiles()
 {
   static_assert(sizeof(audioFilenames)==AU_SPECIAL_SOUND_FIRST*sizeof(char *), "Invalid audioFilenames size");
@@ -284,6 +338,7 @@ void referenceSystemAudioFiles()
   DIR dir;
 
   sdAvailableSystemAudioFiles.reset();
+  wavHeadersReset = true;
 
   char * filename = strAppendSystemAudioPath(path);
   *(filename-1) = '\0';
@@ -423,6 +478,7 @@ void playModelName()
 #endif  // defined(SDCARD)
 
 
+AudioStats audioStats;
 AudioQueue audioQueue __DMA;      // to place it in the RAM section on Horus, to have file buffers in RAM for DMA access
 AudioBuffer audioBuffers[AUDIO_BUFFER_COUNT] __DMA;
 
@@ -456,7 +512,12 @@ void audioTask(void * pdata)
   while (true) {
     DEBUG_TIMER_SAMPLE(debugTimerAudioIterval);
     DEBUG_TIMER_START(debugTimerAudioDuration);
+    uint32_t t0 = timersGetUsTick();
     audioQueue.wakeup();
+    t0 = timersGetUsTick() - t0;
+    audioStats.wakeupLast = t0;
+    if (t0 > audioStats.wakeupMax)
+      audioStats.wakeupMax = t0;
     DEBUG_TIMER_STOP(debugTimerAudioDuration);
     RTOS_WAIT_MS(4);
   }
@@ -473,7 +534,87 @@ inline void mixSample(audio_data_t * result, int sample, unsigned int fade)
 #define RIFF_CHUNK_SIZE 12
 uint8_t wavBuffer[AUDIO_BUFFER_SIZE*2] __DMA;
 
-int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+// Reads the RIFF chunks up to the samples
+static FRESULT readWavHeader(FIL * file, WavHeader & header)
+{
+  UINT read = 0;
+  FRESULT result = f_read(file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
+  if (result != FR_OK || read != RIFF_CHUNK_SIZE+8 || memcmp(wavBuffer, "RIFF", 4) || memcmp(wavBuffer+8, "WAVEfmt ", 8))
+    return FR_DENIED;
+
+  uint32_t size = *((uint32_t *)(wavBuffer+16));
+  result = (size < 256 ? f_read(file, wavBuffer, size+8, &read) : FR_DENIED);
+  if (result != FR_OK || read != size+8)
+    return FR_DENIED;
+
+  header.codec = ((uint16_t *)wavBuffer)[0];
+  header.freq = ((uint16_t *)wavBuffer)[2];
+  uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
+  size = wavSamplesPtr[1];
+  while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
+    result = f_lseek(file, f_tell(file)+size);
+    if (result == FR_OK) {
+      result = f_read(file, wavBuffer, 8, &read);
+      if (read != 8) result = FR_DENIED;
+      wavSamplesPtr = (uint32_t *)wavBuffer;
+      size = wavSamplesPtr[1];
+    }
+  }
+
+  header.dataOffset = f_tell(file);
+  header.dataSize = size;
+  return result;
+}
+
+FRESULT WavContext::openFile()
+{
+  uint32_t t0 = timersGetUsTick();
+  uint32_t pathHash = hash(fragment.file, strlen(fragment.file));
+
+  FRESULT result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
+  fragment.file[1] = 0;
+  if (result != FR_OK)
+    return result;
+
+  WavHeader header;
+  WavHeader * cached = findWavHeader(pathHash, f_size(&state.file));
+  if (cached) {
+    header = *cached;
+    result = f_lseek(&state.file, header.dataOffset);
+    audioStats.headerHits++;
+  }
+  else {
+    result = readWavHeader(&state.file, header);
+    if (result == FR_OK) {
+      header.hash = pathHash;
+      header.fileSize = f_size(&state.file);
+      header.age = 0;
+      addWavHeader(header);
+    }
+  }
+
+  if (result == FR_OK) {
+    state.codec = header.codec;
+    state.freq = header.freq;
+    state.size = header.dataSize;
+    if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
+      state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
+      state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
+    }
+    else {
+      result = FR_DENIED;
+    }
+  }
+
+  t0 = timersGetUsTick() - t0;
+  if (t0 > audioStats.fileOpenMax)
+    audioStats.fileOpenMax = t0;
+  audioStats.fileOpens++;
+
+  return result;
+}
+
+int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade, unsigned int offset)
 {
   FRESULT result = FR_OK;
   UINT read = 0;
@@ -482,61 +623,30 @@ int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
     volume = fragment.fragmentVolume;
 
   if (fragment.file[1]) {
-    result = f_open(&state.file, fragment.file, FA_OPEN_EXISTING | FA_READ);
-    fragment.file[1] = 0;
-    if (result == FR_OK) {
-      result = f_read(&state.file, wavBuffer, RIFF_CHUNK_SIZE+8, &read);
-      if (result == FR_OK && read == RIFF_CHUNK_SIZE+8 && !memcmp(wavBuffer, "RIFF", 4) && !memcmp(wavBuffer+8, "WAVEfmt ", 8)) {
-        uint32_t size = *((uint32_t *)(wavBuffer+16));
-        result = (size < 256 ? f_read(&state.file, wavBuffer, size+8, &read) : FR_DENIED);
-        if (result == FR_OK && read == size+8) {
-          state.codec = ((uint16_t *)wavBuffer)[0];
-          state.freq = ((uint16_t *)wavBuffer)[2];
-          uint32_t *wavSamplesPtr = (uint32_t *)(wavBuffer + size);
-          uint32_t size = wavSamplesPtr[1];
-          if (state.freq != 0 && state.freq * (AUDIO_SAMPLE_RATE / state.freq) == AUDIO_SAMPLE_RATE) {
-            state.resampleRatio = (AUDIO_SAMPLE_RATE / state.freq);
-            state.readSize = (state.codec == CODEC_ID_PCM_S16LE ? 2*AUDIO_BUFFER_SIZE : AUDIO_BUFFER_SIZE) / state.resampleRatio;
-          }
-          else {
-            result = FR_DENIED;
-          }
-          while (result == FR_OK && memcmp(wavSamplesPtr, "data", 4) != 0) {
-            result = f_lseek(&state.file, f_tell(&state.file)+size);
-            if (result == FR_OK) {
-              result = f_read(&state.file, wavBuffer, 8, &read);
-              if (read != 8) result = FR_DENIED;
-              wavSamplesPtr = (uint32_t *)wavBuffer;
-              size = wavSamplesPtr[1];
-            }
-          }
-          state.size = size;
-        }
-        else {
-          result = FR_DENIED;
-        }
-      }
-      else {
-        result = FR_DENIED;
-      }
-    }
+    result = openFile();
   }
 
   if (result == FR_OK) {
+    // only what is left in the buffer when chained after another file
+    uint16_t readSize = state.readSize;
+    if (offset > 0) {
+      readSize = ((AUDIO_BUFFER_SIZE - offset) / state.resampleRatio) * (state.codec == CODEC_ID_PCM_S16LE ? 2 : 1);
+    }
+
     read = 0;
-    result = f_read(&state.file, wavBuffer, state.readSize, &read);
+    result = f_read(&state.file, wavBuffer, readSize, &read);
     if (result == FR_OK) {
       if (read > state.size) {
         read = state.size;
       }
       state.size -= read;
 
-      if (read != state.readSize) {
+      if (read != readSize) {
         f_close(&state.file);
         fragment.clear();
       }
 
-      audio_data_t * samples = buffer->data;
+      audio_data_t * samples = buffer->data + offset;
       if (state.codec == CODEC_ID_PCM_S16LE) {
         read /= 2;
         for (uint32_t i=0; i<read; i++) {
@@ -553,12 +663,12 @@ int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
   if (result != FR_OK) {
     clear();
   }
-  return 0;
+  return offset;
 }
 #else
-int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade)
+int WavContext::mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade, unsigned int offset)
 {
-  return 0;
+  return offset;
 }
 #endif
 
@@ -690,7 +800,21 @@ void AudioQueue::wakeup()
       normalContext.setFragment(fragmentsFifo.get());
       RTOS_UNLOCK_MUTEX(audioMutex);
     }
+    bool wasFile = normalContext.isFile();
     result = normalContext.mixBuffer(buffer, g_eeGeneral.beepVolume, g_eeGeneral.wavVolume, fade);
+
+    // the files following a file which ended are mixed in the same buffer,
+    // so that the prompts of a value are played without gaps
+    while (wasFile && result < AUDIO_BUFFER_SIZE && normalContext.isEmpty() && fragmentsFifo.nextIsFile()) {
+      RTOS_LOCK_MUTEX(audioMutex);
+      normalContext.setFragment(fragmentsFifo.get());
+      RTOS_UNLOCK_MUTEX(audioMutex);
+      if (!normalContext.isFile())
+        break;
+      audioStats.joins++;
+      result = normalContext.mixBuffer(buffer, g_eeGeneral.beepVolume, g_eeGeneral.wavVolume, fade, result);
+    }
+
     if (result > 0) {
       size = max(size, result);
       fade += 1;
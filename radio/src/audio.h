@@ -232,7 +232,9 @@ class WavContext {
 
     inline void clear() { fragment.clear(); };
 
-    int mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade);
+    // mixes the samples from 'offset' up to the end of the buffer,
+    // returns the end of the samples mixed
+    int mixBuffer(AudioBuffer *buffer, int volume, unsigned int fade, unsigned int offset = 0);
     bool hasPromptId(uint8_t id) const { return fragment.id == id; };
 
     void setFragment(const char * filename, uint8_t repeat, int8_t fragmentVolume, uint8_t id)
@@ -250,6 +252,8 @@ class WavContext {
   private:
     AudioFragment fragment;
 
+    FRESULT openFile();
+
     struct {
       FIL      file;
       uint8_t  codec;
@@ -288,12 +292,12 @@ class MixedContext {
     bool isFile() const { return fragment.type == FRAGMENT_FILE; };
     bool hasPromptId(uint8_t id) const { return fragment.id == id; };
 
-    int mixBuffer(AudioBuffer *buffer, int toneVolume, int wavVolume, unsigned int fade)
+    int mixBuffer(AudioBuffer *buffer, int toneVolume, int wavVolume, unsigned int fade, unsigned int offset = 0)
     {
       if (isTone())
         return tone.mixBuffer(buffer, toneVolume, fade);
       else if (isFile())
-        return wav.mixBuffer(buffer, wavVolume, fade);
+        return wav.mixBuffer(buffer, wavVolume, fade, offset);
       return 0;
     }
 
@@ -474,6 +478,11 @@ class AudioFragmentFifo
       return ridx == nextIdx(widx);
     }
 
+    bool nextIsFile() const
+    {
+      return !empty() && fragments[ridx].type == FRAGMENT_FILE;
+    }
+
     void clear()
     {
       widx = ridx;                      // clean the queue
@@ -543,6 +552,17 @@ class AudioQueue {
 extern uint8_t currentSpeakerVolume;
 extern AudioQueue audioQueue;
 
+struct AudioStats {
+  uint32_t wakeupLast;   // audio task duration (us)
+  uint32_t wakeupMax;
+  uint32_t fileOpenMax;  // opening a file up to its samples (us)
+  uint32_t fileOpens;
+  uint32_t headerHits;   // files opened with a cached header
+  uint32_t joins;        // files chained in the same buffer
+};
+
+extern AudioStats audioStats;
+
 enum {
   // IDs for special functions [0:64]
   // IDs for global functions [64:128]
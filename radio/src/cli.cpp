@@ -37,6 +37,7 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "file_sink.h"
 
 #include "cli.h"
 
@@ -859,6 +860,9 @@ int cliStackInfo(const char ** argv)
   cliSerialPrint("[MIXER] %d available / %d bytes", mixerStack.available()*4, mixerStack.size());
   cliSerialPrint("[AUDIO] %d available / %d bytes", audioStack.available()*4, audioStack.size());
   cliSerialPrint("[CLI] %d available / %d bytes", cliStack.available()*4, cliStack.size());
+#if defined(SDCARD)
+  cliSerialPrint("[SINKS] %d available / %d bytes", fileSinksStack.available()*4, fileSinksStack.size());
+#endif
   return 0;
 }
 
@@ -1258,6 +1262,12 @@ void printAudioVars()
 
   cliSerialPrint("normalContext: %u",
               (uint32_t)audioQueue.normalContext.fragment.type);
+
+  cliSerialPrint("audioTask: last %uus, max %uus",
+              audioStats.wakeupLast, audioStats.wakeupMax);
+  cliSerialPrint("files: %u opened (%u cached headers), max %uus, %u joined",
+              audioStats.fileOpens, audioStats.headerHits,
+              audioStats.fileOpenMax, audioStats.joins);
 }
 #endif
 
@@ -1384,11 +1394,36 @@ int cliDisplay(const char ** argv)
     printAudioVars();
   }
 #endif
+#if defined(SDCARD)
+  else if (!strcmp(argv[1], "sinks")) {
+    for (FileSink * sink = fileSinks; sink; sink = sink->next) {
+      const FileSinkStats & stats = sink->getStats();
+      cliSerialPrint("%s: written %u, dropped %u (%u overflows), errors %u, max used %u",
+                     sink->getName(), stats.written, stats.dropped,
+                     stats.overflows, stats.writeErrors, stats.maxUsed);
+    }
+  }
+#endif
 #if defined(DISK_CACHE)
   else if (!strcmp(argv[1], "dc")) {
     DiskCacheStats stats = diskCache.getStats();
     uint32_t hitRate = diskCache.getHitRate();
     cliSerialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
+    cliSerialPrint("  evictions: %u, read ahead: %u (used %u), pinned: %u", stats.noEvictions, stats.noReadAheads, stats.noReadAheadHits, stats.noPinned);
+  }
+#endif
+#if defined(LUA)
+  else if (!strcmp(argv[1], "luafifo")) {
+    if (luaInputTelemetryFifo) {
+      cliSerialPrint("Lua telemetry fifo: used %u/%u, max used %u, dropped %u frames (%u bytes)",
+                     luaInputTelemetryFifo->size(), LUA_TELEMETRY_INPUT_FIFO_SIZE,
+                     luaInputTelemetryFifo->getHighWatermark(),
+                     luaInputTelemetryFifo->getRejectedFrames(),
+                     luaInputTelemetryFifo->getOverflows());
+    }
+    else {
+      cliSerialPrint("Lua telemetry fifo: not allocated");
+    }
   }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
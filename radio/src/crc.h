@@ -35,4 +35,141 @@ uint8_t crc8(const uint8_t * ptr, uint32_t len);
 uint8_t crc8_BA(const uint8_t * ptr, uint32_t len);
 uint16_t crc16(uint8_t index, const uint8_t * buf, uint32_t len, uint16_t start = 0);
 
+// Number of bytes processed at a time by the table driven CRC below:
+// one 256 entries table is needed for each of them
+#if !defined(CRC_SLICES)
+  #if defined(BOOT)
+    #define CRC_SLICES  1
+  #else
+    #define CRC_SLICES  4
+  #endif
+#endif
+
+template <unsigned... I>
+struct CrcIndexes {
+};
+
+template <class A, class B>
+struct CrcConcatIndexes;
+
+template <unsigned... I, unsigned... J>
+struct CrcConcatIndexes<CrcIndexes<I...>, CrcIndexes<J...>> {
+  typedef CrcIndexes<I..., (sizeof...(I) + J)...> type;
+};
+
+// 0 .. N-1, built in log(N) steps
+template <unsigned N>
+struct CrcMakeIndexes
+    : CrcConcatIndexes<typename CrcMakeIndexes<N / 2>::type,
+                       typename CrcMakeIndexes<N - N / 2>::type> {
+};
+
+template <>
+struct CrcMakeIndexes<0> {
+  typedef CrcIndexes<> type;
+};
+
+template <>
+struct CrcMakeIndexes<1> {
+  typedef CrcIndexes<0> type;
+};
+
+// Table driven CRC of width 8 or 16 bits, updated MSB first:
+//   crc = (crc << 8) ^ table[(crc >> (width - 8)) ^ byte]
+//
+// The table is generated at build time from the polynomial, shifting
+// left (or right if REFLECTED) for each bit. With SLICES > 1, SLICES
+// bytes are processed at a time (slicing-by-N): table k gives the CRC of
+// a byte followed by k zero bytes, so that the lookups of a slice do not
+// depend on each other.
+template <typename T, T POLY, bool REFLECTED, unsigned SLICES = CRC_SLICES>
+class Crc
+{
+    static_assert(SLICES == 1 || SLICES >= sizeof(T),
+                  "the CRC must fit in a slice");
+
+    static constexpr unsigned BITS = sizeof(T) * 8;
+
+    struct Table {
+      T values[SLICES * 256];
+    };
+
+    static constexpr T bit(T c)
+    {
+      return REFLECTED ? T((c & 1) ? (c >> 1) ^ POLY : c >> 1)
+                       : T((c >> (BITS - 1)) ? (c << 1) ^ POLY : c << 1);
+    }
+
+    static constexpr T bits(T c, unsigned n)
+    {
+      return n == 0 ? c : bits(bit(c), n - 1);
+    }
+
+    static constexpr T entry(unsigned i)
+    {
+      return bits(REFLECTED ? T(i) : T(i << (BITS - 8)), 8);
+    }
+
+    // entry i followed by k zero bytes
+    static constexpr T slice(unsigned i, unsigned k)
+    {
+      return k == 0 ? entry(i)
+                    : T(T(slice(i, k - 1) << 8) ^
+                        entry(slice(i, k - 1) >> (BITS - 8)));
+    }
+
+    template <unsigned... I>
+    static constexpr Table makeTable(CrcIndexes<I...>)
+    {
+      return {{slice(I % 256, I / 256)...}};
+    }
+
+  public:
+    static constexpr Table table =
+        makeTable(typename CrcMakeIndexes<SLICES * 256>::type());
+
+    static T compute(const uint8_t * buf, uint32_t len, T crc = 0)
+    {
+      const T * tab = table.values;
+
+      if (SLICES > 1) {
+        while (len >= SLICES) {
+          // the CRC is merged into the first bytes of the slice
+          T value = 0;
+          for (unsigned k = 0; k < SLICES; k++) {
+            uint8_t byte = buf[k];
+            if (k < sizeof(T)) byte ^= crc >> (BITS - 8 * (k + 1));
+            value ^= tab[(SLICES - 1 - k) * 256 + byte];
+          }
+          crc = value;
+          buf += SLICES;
+          len -= SLICES;
+        }
+      }
+
+      while (len--) {
+        crc = T(crc << 8) ^ tab[((crc >> (BITS - 8)) ^ *buf++) & 0xFF];
+      }
+
+      return crc;
+    }
+};
+
+template <typename T, T POLY, bool REFLECTED, unsigned SLICES>
+constexpr typename Crc<T, POLY, REFLECTED, SLICES>::Table
+    Crc<T, POLY, REFLECTED, SLICES>::table;
+
+// CRC16 according to CCITT standards
+typedef Crc<uint16_t, 0x1021, false> Crc16_1021;
+
+// CRC_1189: table of the reflected 0x8408 polynomial (entry 1 is 0x1189),
+// used with the same MSB first update as CRC_1021
+typedef Crc<uint16_t, 0x8408, true> Crc16_1189;
+
+// polynom = x^8+x^7+x^6+x^4+x^2+1 (0xD5)
+typedef Crc<uint8_t, 0xD5, false> Crc8_D5;
+
+// polynom = 0xBA, only used on a few bytes
+typedef Crc<uint8_t, 0xBA, false, 1> Crc8_BA;
+
 #endif
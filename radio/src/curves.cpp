@@ -74,6 +74,7 @@ void loadCurves()
     curveEnd[i] = tmp;
 
   }
+  curvesCacheInvalidate();
   if (showWarning) {
     POPUP_WARNING("Invalid curve data repaired", "check your curves, logic switches");
   }
@@ -228,6 +229,118 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
   return m;
 }
 
+// Smooth curves cache: the knots and tangents of the hermite spline are
+// computed once after each model change instead of on every call. The
+// spline is evaluated with the same integer arithmetic, the results are
+// the same as without the cache.
+struct CurveCache {
+  uint8_t count;
+  int16_t x[MAX_POINTS_PER_CURVE];
+  int16_t y[MAX_POINTS_PER_CURVE];
+  int32_t m[MAX_POINTS_PER_CURVE];
+};
+
+static CurveCache _curve_caches[MAX_CURVE_CACHES];
+static uint8_t _curve_cache_slot[MAX_CURVES];  // cache index + 1, 0 if none
+
+// the cache is valid when both serials are the same
+static volatile uint8_t _curves_serial = 1;
+static uint8_t _curves_cache_serial = 0;
+
+void curvesCacheInvalidate()
+{
+  _curves_serial++;
+}
+
+static int32_t getSplineKnotX(uint8_t count, bool custom,
+                              const int8_t* points, int i)
+{
+  if (custom) {
+    if (i == 0) return -RESX;
+    if (i == count - 1) return RESX;
+    return calc100toRESX(points[count + i - 1]);
+  }
+  return -RESX + (i * 2 * RESX) / (count - 1);
+}
+
+static void buildCurveCache(CurveCache& cache, uint8_t idx)
+{
+  CurveHeader& crv = g_model.curves[idx];
+  int8_t* points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+
+  cache.count = count;
+  for (int i = 0; i < count; i++) {
+    cache.x[i] = getSplineKnotX(count, custom, points, i);
+    cache.y[i] = calc100toRESX(points[i]);
+    cache.m[i] = compute_tangent(&crv, points, i);
+  }
+}
+
+void curvesCacheUpdate()
+{
+#if defined(SIMU)
+  if (modelCachesAlwaysRebuild) curvesCacheInvalidate();
+#endif
+
+  uint8_t serial = _curves_serial;
+  if (serial == _curves_cache_serial)
+    return;
+
+  // the smooth curves are cached in curves order
+  uint8_t slot = 0;
+  for (uint8_t idx = 0; idx < MAX_CURVES; idx++) {
+    CurveHeader& crv = g_model.curves[idx];
+    uint8_t count = STD_CURVE_POINTS(crv.points);
+    if (crv.smooth && slot < MAX_CURVE_CACHES && count >= 2 &&
+        count <= MAX_POINTS_PER_CURVE) {
+      buildCurveCache(_curve_caches[slot], idx);
+      _curve_cache_slot[idx] = ++slot;
+    } else {
+      _curve_cache_slot[idx] = 0;
+    }
+  }
+
+  // an invalidation while building
+  // will trigger another build on next call
+  _curves_cache_serial = serial;
+}
+
+bool isCurveCached(uint8_t idx)
+{
+  return idx < MAX_CURVES && _curves_cache_serial == _curves_serial &&
+         _curve_cache_slot[idx];
+}
+
+static int16_t hermiteSegment(int32_t x, int32_t p0x, int32_t p3x,
+                              int32_t p0y, int32_t p3y, int32_t m0, int32_t m3)
+{
+  int32_t y;
+  int32_t h = p3x - p0x;
+  int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
+  int32_t t2 = t * t / MMULT;
+  int32_t t3 = t2 * t / MMULT;
+  int32_t h00 = 2*t3 - 3*t2 + MMULT;
+  int32_t h10 = t3 - 2*t2 + t;
+  int32_t h01 = -2*t3 + 3*t2;
+  int32_t h11 = t3 - t2;
+  y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
+  y /= MMULT;
+  return y;
+}
+
+static int16_t cachedHermiteSpline(int16_t x, const CurveCache& cache)
+{
+  for (int i=0; i<cache.count-1; i++) {
+    if (x >= cache.x[i] && x <= cache.x[i+1]) {
+      return hermiteSegment(x, cache.x[i], cache.x[i+1], cache.y[i],
+                            cache.y[i+1], cache.m[i], cache.m[i+1]);
+    }
+  }
+  return 0;
+}
+
 /* The following is a hermite cubic spline.
    The basis functions can be found here:
    http://en.wikipedia.org/wiki/Cubic_Hermite_spline
@@ -235,44 +348,28 @@ int32_t compute_tangent(CurveHeader* crv, const int8_t* points, int i)
 */
 int16_t hermite_spline(int16_t x, uint8_t idx)
 {
-  CurveHeader &crv = g_model.curves[idx];
-  int8_t *points = curveAddress(idx);
-  uint8_t count = STD_CURVE_POINTS(crv.points);
-  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
-
   if (x < -RESX)
     x = -RESX;
   else if (x > RESX)
     x = RESX;
 
-  for (int i=0; i<count-1; i++) {
-    int32_t p0x, p3x;
-    if (custom) {
-      p0x = (i>0 ? calc100toRESX(points[count+i-1]) : -RESX);
-      p3x = (i<count-2 ? calc100toRESX(points[count+i]) : RESX);
-    }
-    else {
-      p0x = -RESX + (i*2*RESX)/(count-1);
-      p3x = -RESX + ((i+1)*2*RESX)/(count-1);
-    }
+  if (isCurveCached(idx)) {
+    return cachedHermiteSpline(x, _curve_caches[_curve_cache_slot[idx] - 1]);
+  }
 
+  CurveHeader &crv = g_model.curves[idx];
+  int8_t *points = curveAddress(idx);
+  uint8_t count = STD_CURVE_POINTS(crv.points);
+  bool custom = (crv.type == CURVE_TYPE_CUSTOM);
+
+  for (int i=0; i<count-1; i++) {
+    int32_t p0x = getSplineKnotX(count, custom, points, i);
+    int32_t p3x = getSplineKnotX(count, custom, points, i+1);
     if (x >= p0x && x <= p3x) {
-      int32_t p0y = calc100toRESX(points[i]);
-      int32_t p3y = calc100toRESX(points[i+1]);
-      int32_t m0 = compute_tangent(&crv, points, i);
-      int32_t m3 = compute_tangent(&crv, points, i+1);
-      int32_t y;
-      int32_t h = p3x - p0x;
-      int32_t t = (h > 0 ? (MMULT * (x - p0x)) / h : 0);
-      int32_t t2 = t * t / MMULT;
-      int32_t t3 = t2 * t / MMULT;
-      int32_t h00 = 2*t3 - 3*t2 + MMULT;
-      int32_t h10 = t3 - 2*t2 + t;
-      int32_t h01 = -2*t3 + 3*t2;
-      int32_t h11 = t3 - t2;
-      y = p0y * h00 + h * (m0 * h10 / MMULT) + p3y * h01 + h * (m3 * h11 / MMULT);
-      y /= MMULT;
-      return y;
+      return hermiteSegment(x, p0x, p3x, calc100toRESX(points[i]),
+                            calc100toRESX(points[i+1]),
+                            compute_tangent(&crv, points, i),
+                            compute_tangent(&crv, points, i+1));
     }
   }
   return 0;
@@ -47,6 +47,19 @@ int applyCustomCurve(int x, uint8_t idx);
 int applyCurve(int x, CurveRef & curve);
 int applyCurrentCurve(int x);
 
+// Number of smooth curves whose spline knots and tangents are cached
+#if defined(COLORLCD)
+  #define MAX_CURVE_CACHES 16
+#else
+  #define MAX_CURVE_CACHES 8
+#endif
+
+// The cache is invalidated by storageDirty(EE_MODEL) and loadCurves(),
+// and rebuilt by the mixer.
+void curvesCacheInvalidate();
+void curvesCacheUpdate();
+bool isCurveCached(uint8_t idx);
+
 char *getCurveRefString(char *dest, size_t len, const CurveRef& curve);
 
 #endif
@@ -35,106 +35,201 @@
 #error "Variable sector size is not supported"
 #endif
 
+#if (DISK_CACHE_HASH_SIZE & (DISK_CACHE_HASH_SIZE - 1)) != 0
+#error "DISK_CACHE_HASH_SIZE must be a power of 2"
+#endif
+
 #define BLOCK_SIZE FF_MAX_SS
 #define DISK_CACHE_BLOCK_SIZE (DISK_CACHE_BLOCK_SECTORS * BLOCK_SIZE)
 
+#define NO_BLOCK  ((DWORD)-1)
+
 DiskCache diskCache;
 
-class DiskCacheBlock
+DiskCache::DiskCache() :
+  data(nullptr),
+  clockHand(0),
+  nextBlock(NO_BLOCK),
+  pinnedStart(0),
+  pinnedEnd(0),
+  diskDrv(nullptr),
+  sectors(0)
 {
- public:
-  DiskCacheBlock();
-  bool read(BYTE* buff, DWORD sector, UINT count);
-  DRESULT fill(const diskio_driver_t* drv, BYTE lun, BYTE* buff, DWORD sector,
-               UINT count);
-  void free(DWORD sector, UINT count);
-  void free();
-  bool empty() const;
-
- private:
-  uint8_t data[DISK_CACHE_BLOCK_SIZE];
-  DWORD startSector;
-  DWORD endSector;
-};
+  memset(&stats, 0, sizeof(stats));
+  memset(blocks, 0, sizeof(blocks));
+  memset(hash, -1, sizeof(hash));
+}
 
-DiskCacheBlock::DiskCacheBlock():
-  startSector(0),
-  endSector(0) 
+void DiskCache::initialize(const diskio_driver_t* drv)
 {
+  // one buffer for all blocks, so that 2 consecutive blocks
+  // can be read at once
+  if (!data) data = new uint8_t[DISK_CACHE_BLOCKS_NUM * DISK_CACHE_BLOCK_SIZE];
+  diskDrv = drv;
 }
 
-bool DiskCacheBlock::read(BYTE * buff, DWORD sector, UINT count)
+void DiskCache::clear()
 {
-  if (sector >= startSector && (sector+count) <= endSector) {
-    TRACE_DISK_CACHE("\tcache read(%u, %u) from %p", (uint32_t)sector, (uint32_t)count, this);
-    memcpy(buff, data + ((sector - startSector) * BLOCK_SIZE), count * BLOCK_SIZE);
-    return true;
-  }
-  return false;
+  memset(&stats, 0, sizeof(stats));
+  memset(blocks, 0, sizeof(blocks));
+  memset(hash, -1, sizeof(hash));
+  clockHand = 0;
+  nextBlock = NO_BLOCK;
+  pinnedStart = pinnedEnd = 0;
+  // the card may have been changed
+  sectors = 0;
 }
 
-DRESULT DiskCacheBlock::fill(const diskio_driver_t* drv, BYTE lun, BYTE * buff,
-			     DWORD sector, UINT count)
+void DiskCache::setPinnedSectors(DWORD start, DWORD end)
 {
-  DRESULT res = drv->read(lun, data, sector, DISK_CACHE_BLOCK_SECTORS);
-  if (res != RES_OK) {
-    return res;
+  pinnedStart = start;
+  pinnedEnd = end;
+
+  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
+    Block& block = blocks[n];
+    if (block.valid && !block.pinned &&
+        stats.noPinned < DISK_CACHE_PINNED_MAX &&
+        block.number * DISK_CACHE_BLOCK_SECTORS < pinnedEnd &&
+        (block.number + 1) * DISK_CACHE_BLOCK_SECTORS > pinnedStart) {
+      block.pinned = 1;
+      ++stats.noPinned;
+    }
   }
-  startSector = sector;
-  endSector = sector + DISK_CACHE_BLOCK_SECTORS;
-  memcpy(buff, data, count * BLOCK_SIZE);
-  TRACE_DISK_CACHE("cache %p FILLED from read(%u, %u)", this, (uint32_t)sector, (uint32_t)count);
-  return RES_OK;
 }
 
-void DiskCacheBlock::free(DWORD sector, UINT count) 
+uint32_t DiskCache::getSectors(uint8_t lun)
 {
-  if (sector < endSector && (sector+count) > startSector) {
-    TRACE_DISK_CACHE("\tINVALIDATING disk cache block %p (%u)", this, startSector);
-    endSector = 0;
+  if (sectors == 0) {
+    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
   }
+  return sectors;
 }
 
-void DiskCacheBlock::free()
+uint8_t* DiskCache::getData(int index)
 {
-  endSector = 0;
+  return data + index * DISK_CACHE_BLOCK_SIZE;
 }
 
-bool DiskCacheBlock::empty() const
+int DiskCache::find(DWORD number) const
 {
-  return (endSector == 0);
+  int n = hash[number & (DISK_CACHE_HASH_SIZE - 1)];
+  while (n >= 0 && blocks[n].number != number) {
+    n = blocks[n].next;
+  }
+  return n;
 }
 
-DiskCache::DiskCache() : lastBlock(0), blocks(nullptr), diskDrv(nullptr)
+void DiskCache::insert(int index, DWORD number, bool readAhead)
 {
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
+  Block& block = blocks[index];
+  int8_t& head = hash[number & (DISK_CACHE_HASH_SIZE - 1)];
+
+  block.number = number;
+  block.next = head;
+  head = index;
+
+  block.valid = 1;
+  // a block read ahead is replaced first if it is not used
+  block.referenced = !readAhead;
+  block.readAhead = readAhead;
+  block.pinned = 0;
+
+  if (stats.noPinned < DISK_CACHE_PINNED_MAX &&
+      number * DISK_CACHE_BLOCK_SECTORS < pinnedEnd &&
+      (number + 1) * DISK_CACHE_BLOCK_SECTORS > pinnedStart) {
+    TRACE_DISK_CACHE("\tpinned block %u", (uint32_t)number);
+    block.pinned = 1;
+    ++stats.noPinned;
+  }
 }
 
-void DiskCache::initialize(const diskio_driver_t* drv)
+void DiskCache::remove(int index)
 {
-  blocks = new DiskCacheBlock[DISK_CACHE_BLOCKS_NUM];
-  diskDrv = drv;
+  Block& block = blocks[index];
+  if (!block.valid) return;
+
+  int8_t* n = &hash[block.number & (DISK_CACHE_HASH_SIZE - 1)];
+  while (*n != index) {
+    n = &blocks[*n].next;
+  }
+  *n = block.next;
+
+  if (block.pinned) {
+    --stats.noPinned;
+  }
+  block.valid = 0;
+  block.pinned = 0;
 }
 
-void DiskCache::clear()
+// CLOCK replacement: the blocks used since the last turn get a second
+// chance, the pinned blocks are never replaced
+int DiskCache::getVictim()
 {
-  lastBlock = 0;
-  stats.noHits = 0;
-  stats.noMisses = 0;
-  stats.noWrites = 0;
   for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free();
+    if (!blocks[n].valid) return n;
+  }
+
+  for (int turn = 0; turn < 2 * DISK_CACHE_BLOCKS_NUM; ++turn) {
+    int n = clockHand;
+    clockHand = (clockHand + 1) % DISK_CACHE_BLOCKS_NUM;
+
+    Block& block = blocks[n];
+    if (block.pinned) continue;
+    if (block.referenced) {
+      block.referenced = 0;
+      continue;
+    }
+    return n;
   }
+
+  return -1;
 }
 
-uint32_t DiskCache::getSectors(uint8_t lun)
+// Reads a block into the cache. When the reads are sequential, the
+// next block is read in the same transfer if the following cache block
+// can be replaced. Returns the block index, or -1 if the cache is full of
+// pinned blocks.
+DRESULT DiskCache::readBlock(BYTE lun, DWORD number, int& index)
 {
-  if (sectors == 0) {
-    diskDrv->ioctl(lun, GET_SECTOR_COUNT, &sectors);
+  index = getVictim();
+  if (index < 0) return RES_OK;
+
+  int ahead = -1;
+  if (number == nextBlock && index + 1 < DISK_CACHE_BLOCKS_NUM &&
+      (number + 2) * DISK_CACHE_BLOCK_SECTORS <= getSectors(lun) &&
+      find(number + 1) < 0) {
+    const Block& block = blocks[index + 1];
+    if (!block.valid || (!block.pinned && !block.referenced)) {
+      ahead = index + 1;
+    }
   }
-  return sectors;
+
+  if (blocks[index].valid) {
+    ++stats.noEvictions;
+    remove(index);
+  }
+
+  if (ahead >= 0 && blocks[ahead].valid) {
+    ++stats.noEvictions;
+    remove(ahead);
+  }
+
+  UINT count = (ahead >= 0 ? 2 : 1) * DISK_CACHE_BLOCK_SECTORS;
+  DRESULT res = diskDrv->read(lun, getData(index),
+                              number * DISK_CACHE_BLOCK_SECTORS, count);
+  if (res != RES_OK) {
+    return res;
+  }
+
+  TRACE_DISK_CACHE("cache block %d FILLED with %u (%u sectors)", index,
+                   (uint32_t)number, count);
+  insert(index, number, false);
+  if (ahead >= 0) {
+    insert(ahead, number + 1, true);
+    ++stats.noReadAheads;
+  }
+
+  return RES_OK;
 }
 
 DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
@@ -144,48 +239,100 @@ DRESULT DiskCache::read(BYTE lun, BYTE * buff, DWORD sector, UINT count)
     TRACE_DISK_CACHE("big read(%u, %u)",  (uint32_t)sector, (uint32_t)count);
     return diskDrv->read(lun, buff, sector, count);
   }
-  
-  // if block + cache block size is beyond the end of the disk,
-  // then read it directly without using cache
-  if (sector + DISK_CACHE_BLOCK_SECTORS >= getSectors(lun)) {
-    TRACE_DISK_CACHE("cache would be beyond end of disk %u (%u)",
-		     (uint32_t)sector, getSectors(lun));
-    return diskDrv->read(lun, buff, sector, count);
-  }
 
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].read(buff, sector, count)) {
-      ++stats.noHits;
-      return RES_OK;
+  while (count > 0) {
+    DWORD number = sector / DISK_CACHE_BLOCK_SECTORS;
+    UINT offset = sector % DISK_CACHE_BLOCK_SECTORS;
+    UINT n = DISK_CACHE_BLOCK_SECTORS - offset;
+    if (n > count) n = count;
+
+    // if the cache block is beyond the end of the disk,
+    // then read it directly without using cache
+    if ((number + 1) * DISK_CACHE_BLOCK_SECTORS > getSectors(lun)) {
+      TRACE_DISK_CACHE("cache would be beyond end of disk %u (%u)",
+                       (uint32_t)sector, getSectors(lun));
+      return diskDrv->read(lun, buff, sector, count);
     }
-  }
 
-  ++stats.noMisses;
+    int index = find(number);
+    if (index >= 0) {
+      Block& block = blocks[index];
+      block.referenced = 1;
+      if (block.readAhead) {
+        block.readAhead = 0;
+        ++stats.noReadAheadHits;
+      }
+      ++stats.noHits;
+    }
+    else {
+      ++stats.noMisses;
+      DRESULT res = readBlock(lun, number, index);
+      if (res != RES_OK) {
+        return res;
+      }
+    }
 
-  // find free block
-  for (int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    if (blocks[n].empty()) {
-      TRACE_DISK_CACHE("\t\t using free block");
-      return blocks[n].fill(diskDrv, lun, buff, sector, count);
+    if (index >= 0) {
+      TRACE_DISK_CACHE("\tcache read(%u, %u) from %d", (uint32_t)sector, n, index);
+      memcpy(buff, getData(index) + offset * BLOCK_SIZE, n * BLOCK_SIZE);
+    }
+    else {
+      DRESULT res = diskDrv->read(lun, buff, sector, n);
+      if (res != RES_OK) {
+        return res;
+      }
     }
-  }
 
-  // use next block (round robin)
-  // TODO: use better strategy to select which used block gets used here
-  if (++lastBlock >= DISK_CACHE_BLOCKS_NUM) {
-    lastBlock = 0;
+    nextBlock = number + 1;
+    buff += n * BLOCK_SIZE;
+    sector += n;
+    count -= n;
   }
-  
-  return blocks[lastBlock].fill(diskDrv, lun, buff, sector, count);
+
+  return RES_OK;
 }
 
 DRESULT DiskCache::write(BYTE lun, const BYTE* buff, DWORD sector, UINT count)
 {
   ++stats.noWrites;
-  for(int n = 0; n < DISK_CACHE_BLOCKS_NUM; ++n) {
-    blocks[n].free(sector, count);
+
+  DRESULT res = diskDrv->write(lun, buff, sector, count);
+
+  // update the cached copies, or drop them if the write failed
+  DWORD first = sector / DISK_CACHE_BLOCK_SECTORS;
+  DWORD last = (sector + count - 1) / DISK_CACHE_BLOCK_SECTORS;
+  bool lookup = (last - first) < DISK_CACHE_BLOCKS_NUM;
+
+  for (DWORD i = 0; i <= (lookup ? last - first : DISK_CACHE_BLOCKS_NUM - 1); ++i) {
+    int index;
+    if (lookup) {
+      index = find(first + i);
+      if (index < 0) continue;
+    }
+    else {
+      index = i;
+      if (!blocks[index].valid) continue;
+    }
+
+    DWORD start = blocks[index].number * DISK_CACHE_BLOCK_SECTORS;
+    DWORD from = sector > start ? sector : start;
+    DWORD to = sector + count < start + DISK_CACHE_BLOCK_SECTORS
+                   ? sector + count
+                   : start + DISK_CACHE_BLOCK_SECTORS;
+    if (from >= to) continue;
+
+    if (res == RES_OK) {
+      TRACE_DISK_CACHE("\tUPDATING disk cache block %d (%u)", index, start);
+      memcpy(getData(index) + (from - start) * BLOCK_SIZE,
+             buff + (from - sector) * BLOCK_SIZE, (to - from) * BLOCK_SIZE);
+    }
+    else {
+      TRACE_DISK_CACHE("\tINVALIDATING disk cache block %d (%u)", index, start);
+      remove(index);
+    }
   }
-  return diskDrv->write(lun, buff, sector, count);
+
+  return res;
 }
 
 const DiskCacheStats & DiskCache::getStats() const 
@@ -209,4 +356,3 @@ DRESULT disk_cache_write(BYTE drv, const BYTE * buff, DWORD sector, UINT count)
 {
   return diskCache.write(drv, buff, sector, count);
 }
-
@@ -26,16 +26,24 @@
 // tunable parameters
 #define DISK_CACHE_BLOCKS_NUM      32   // no cache blocks
 #define DISK_CACHE_BLOCK_SECTORS   16   // no sectors
+#define DISK_CACHE_HASH_SIZE       32   // no hash buckets (power of 2)
+#define DISK_CACHE_PINNED_MAX      8    // max no of pinned blocks
 
 struct DiskCacheStats
 {
   uint32_t noHits;
   uint32_t noMisses;
   uint32_t noWrites;
+  uint32_t noEvictions;
+  uint32_t noReadAheads;     // blocks read ahead
+  uint32_t noReadAheadHits;  // read ahead blocks used afterwards
+  uint16_t noPinned;         // blocks currently pinned
 };
 
-class DiskCacheBlock;
-
+// Write-through cache of aligned blocks of sectors, found by a hash index.
+// Blocks are replaced with the CLOCK algorithm, the blocks in the pinned
+// sectors range (FAT) are not replaced. The next block is read at the same
+// time when the reads are sequential.
 class DiskCache
 {
  public:
@@ -44,6 +52,9 @@ class DiskCache
   void initialize(const diskio_driver_t* drv);
   void clear();
 
+  // blocks in this range are kept in the cache (FAT and root directory)
+  void setPinnedSectors(DWORD start, DWORD end);
+
   DRESULT read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
   DRESULT write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
 
@@ -51,18 +62,36 @@ class DiskCache
   int getHitRate() const;
 
  private:
+  struct Block {
+    DWORD number;      // sector / DISK_CACHE_BLOCK_SECTORS
+    int8_t next;       // next block in the same hash bucket
+    uint8_t valid:1;
+    uint8_t referenced:1;
+    uint8_t pinned:1;
+    uint8_t readAhead:1;
+  };
+
   DiskCacheStats stats;
-  uint32_t lastBlock;
-  DiskCacheBlock* blocks;
+  Block blocks[DISK_CACHE_BLOCKS_NUM];
+  int8_t hash[DISK_CACHE_HASH_SIZE];
+  uint8_t* data;
+  uint8_t clockHand;
+  DWORD nextBlock;     // block following the last one read
+  DWORD pinnedStart;
+  DWORD pinnedEnd;
   const diskio_driver_t* diskDrv;
   uint32_t sectors;
 
   uint32_t getSectors(uint8_t lun);
+  uint8_t* getData(int index);
+  int find(DWORD number) const;
+  void insert(int index, DWORD number, bool readAhead);
+  void remove(int index);
+  int getVictim();
+  DRESULT readBlock(BYTE lun, DWORD number, int& index);
 };
 
 extern DiskCache diskCache;
 
 DRESULT disk_cache_read(BYTE drv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_cache_write(BYTE drv, const BYTE* buff, DWORD sector, UINT count);
-
-
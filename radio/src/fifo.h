@@ -24,6 +24,16 @@
 
 #include <inttypes.h>
 
+// Lock-free single producer / single consumer ring: the producer and the
+// consumer may be an ISR and a task, or two tasks.
+//
+// The indexes are free running: the producer only writes widx and the
+// consumer ridx, each one being published (release) once the elements
+// are written / read, and read by the other side with acquire semantics.
+//
+// Zero-copy access, for DMA and parsers:
+// - producer: reserveContiguous() then commit()
+// - consumer: peekContiguous() then consume()
 template <class T, int N>
 class Fifo
 {
@@ -32,73 +42,186 @@ class Fifo
   public:
     Fifo():
       widx(0),
-      ridx(0)
+      ridx(0),
+      overflows(0),
+      highWatermark(0),
+      rejectedFrames(0)
     {
     }
 
+    // only while neither the producer nor the consumer is running
     void clear()
     {
-      widx = ridx = 0;
+      storeRelease(widx, 0);
+      storeRelease(ridx, 0);
     }
 
-    void push(T element)
+    // Producer side
+
+    bool push(T element)
     {
-      uint32_t next = nextIndex(widx);
-      if (next != ridx) {
-        fifo[widx] = element;
-        widx = next;
+      uint32_t w = widx;
+      if (w - loadAcquire(ridx) >= N) {
+        overflows++;
+        return false;
       }
+      fifo[w & (N - 1)] = element;
+      published(w + 1);
+      return true;
     }
 
-    void skip()
+    // pushes as many elements as possible, returns their count
+    uint32_t push(const T * data, uint32_t count)
     {
-      ridx = nextIndex(ridx);
+      uint32_t w = widx;
+      uint32_t space = N - (w - loadAcquire(ridx));
+      if (count > space) {
+        overflows += count - space;
+        count = space;
+      }
+      copyIn(w, data, count);
+      published(w + count);
+      return count;
     }
 
-    bool pop(T & element)
+    // pushes all the elements or none of them, for the producers of
+    // whole frames: the frames rejected are counted
+    bool pushFrame(const T * data, uint32_t count)
     {
-      if (isEmpty()) {
+      uint32_t w = widx;
+      if (count > N - (w - loadAcquire(ridx))) {
+        overflows += count;
+        rejectedFrames++;
         return false;
       }
-      else {
-        element = fifo[ridx];
-        ridx = nextIndex(ridx);
-        return true;
-      }
+      copyIn(w, data, count);
+      published(w + count);
+      return true;
     }
 
-    bool isEmpty() const
+    // free space after widx, up to the end of the buffer
+    uint32_t reserveContiguous(T ** data)
     {
-      return (ridx == widx);
+      uint32_t w = widx;
+      uint32_t space = N - (w - loadAcquire(ridx));
+      uint32_t pos = w & (N - 1);
+      *data = &fifo[pos];
+      return space < N - pos ? space : N - pos;
+    }
+
+    // publishes the elements written after reserveContiguous()
+    void commit(uint32_t count)
+    {
+      published(widx + count);
+    }
+
+    bool hasSpace(uint32_t n) const
+    {
+      return size() + n <= N;
     }
 
     bool isFull() const
     {
-      uint32_t next = nextIndex(widx);
-      return (next == ridx);
+      return size() >= N;
     }
 
-    uint32_t size() const
+    // Consumer side
+
+    bool pop(T & element)
     {
-      return (N + widx - ridx) & (N - 1);
+      uint32_t r = ridx;
+      if (r == loadAcquire(widx)) {
+        return false;
+      }
+      element = fifo[r & (N - 1)];
+      storeRelease(ridx, r + 1);
+      return true;
     }
 
-    bool hasSpace(uint32_t n) const
+    // pops up to 'count' elements, returns their count
+    uint32_t pop(T * data, uint32_t count)
     {
-      return (N > (size() + n));
+      uint32_t r = ridx;
+      uint32_t available = loadAcquire(widx) - r;
+      if (count > available) {
+        count = available;
+      }
+      copyOut(r, data, count);
+      storeRelease(ridx, r + count);
+      return count;
     }
 
     bool probe(T & element) const
     {
-      if (isEmpty()) {
+      uint32_t r = ridx;
+      if (r == loadAcquire(widx)) {
         return false;
       }
-      else {
-        element = fifo[ridx];
-        return true;
+      element = fifo[r & (N - 1)];
+      return true;
+    }
+
+    // elements available after ridx, up to the end of the buffer
+    uint32_t peekContiguous(const T ** data) const
+    {
+      uint32_t r = ridx;
+      uint32_t available = loadAcquire(widx) - r;
+      uint32_t pos = r & (N - 1);
+      *data = &fifo[pos];
+      return available < N - pos ? available : N - pos;
+    }
+
+    // releases the elements read after peekContiguous()
+    void consume(uint32_t count)
+    {
+      storeRelease(ridx, ridx + count);
+    }
+
+    void skip()
+    {
+      uint32_t r = ridx;
+      if (r != loadAcquire(widx)) {
+        storeRelease(ridx, r + 1);
       }
     }
 
+    bool isEmpty() const
+    {
+      return size() == 0;
+    }
+
+    // Both sides
+
+    uint32_t size() const
+    {
+      return loadAcquire(widx) - loadAcquire(ridx);
+    }
+
+    // elements dropped because the fifo was full
+    uint32_t getOverflows() const
+    {
+      return overflows;
+    }
+
+    // max number of elements waiting in the fifo
+    uint32_t getHighWatermark() const
+    {
+      return highWatermark;
+    }
+
+    // frames dropped by pushFrame()
+    uint32_t getRejectedFrames() const
+    {
+      return rejectedFrames;
+    }
+
+    void resetStats()
+    {
+      overflows = 0;
+      highWatermark = 0;
+      rejectedFrames = 0;
+    }
+
     T * buffer()
     {
       return fifo;
@@ -106,12 +229,46 @@ class Fifo
 
   protected:
     T fifo[N];
-    volatile uint32_t widx;
-    volatile uint32_t ridx;
+    uint32_t widx;
+    uint32_t ridx;
+    uint32_t overflows;      // written by the producer
+    uint32_t highWatermark;  // written by the producer
+    uint32_t rejectedFrames; // written by the producer
+
+    static inline uint32_t loadAcquire(const uint32_t & idx)
+    {
+      return __atomic_load_n(&idx, __ATOMIC_ACQUIRE);
+    }
+
+    static inline void storeRelease(uint32_t & idx, uint32_t value)
+    {
+      __atomic_store_n(&idx, value, __ATOMIC_RELEASE);
+    }
+
+    void published(uint32_t w)
+    {
+      storeRelease(widx, w);
+      uint32_t used = w - loadAcquire(ridx);
+      if (used > highWatermark) {
+        highWatermark = used;
+      }
+    }
+
+    // the elements are copied in at most 2 parts (buffer end)
+    void copyIn(uint32_t w, const T * data, uint32_t count)
+    {
+      uint32_t pos = w & (N - 1);
+      uint32_t first = count < N - pos ? count : N - pos;
+      for (uint32_t i = 0; i < first; i++) fifo[pos + i] = data[i];
+      for (uint32_t i = first; i < count; i++) fifo[i - first] = data[i];
+    }
 
-    static inline uint32_t nextIndex(uint32_t idx)
+    void copyOut(uint32_t r, T * data, uint32_t count) const
     {
-      return (idx + 1) & (N - 1);
+      uint32_t pos = r & (N - 1);
+      uint32_t first = count < N - pos ? count : N - pos;
+      for (uint32_t i = 0; i < first; i++) data[i] = fifo[pos + i];
+      for (uint32_t i = first; i < count; i++) data[i] = fifo[i - first];
     }
 };
 
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "opentx.h"
+#include "file_sink.h"
+#include "tasks.h"
+
+#define FILE_SINK_PRINT_BUFFER_SIZE  64
+
+FileSink * fileSinks = nullptr;
+
+FileSink::FileSink(const char * name, FIL * file, uint8_t * buffer,
+                   uint16_t chunkSize, uint16_t syncPeriodMs) :
+  next(fileSinks),
+  name(name),
+  file(file),
+  buffer(buffer),
+  chunkSize(chunkSize),
+  syncPeriod(syncPeriodMs),
+  lastSync(0),
+  tail(0),
+  head(0),
+  pending(0),
+  overflow(false),
+  error(false),
+  stats()
+{
+  fileSinks = this;
+}
+
+void FileSink::init()
+{
+  RTOS_CREATE_MUTEX(mutex);
+}
+
+FRESULT FileSink::open(const TCHAR * path, BYTE mode)
+{
+  RTOS_LOCK_MUTEX(mutex);
+  FRESULT result = f_open(file, path, mode);
+  RTOS_UNLOCK_MUTEX(mutex);
+
+  if (result == FR_OK) {
+    start();
+  }
+
+  return result;
+}
+
+void FileSink::start()
+{
+  RTOS_LOCK_MUTEX(mutex);
+  tail = head = pending = f_tell(file);
+  overflow = false;
+  error = false;
+  lastSync = RTOS_GET_MS();
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+void FileSink::close()
+{
+  RTOS_LOCK_MUTEX(mutex);
+  if (isOpen()) {
+    flush(true);
+    if (f_close(file) != FR_OK) {
+      // close failed, forget file
+      file->obj.fs = 0;
+    }
+  }
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+void FileSink::write(const void * data, uint32_t len)
+{
+  const uint32_t size = 2 * chunkSize;
+
+  if (overflow || pending - tail + len > size) {
+    overflow = true;
+    stats.dropped += len;
+    return;
+  }
+
+  auto src = (const uint8_t *)data;
+  while (len > 0) {
+    uint32_t pos = pending % size;
+    uint32_t count = len < size - pos ? len : size - pos;
+    memcpy(&buffer[pos], src, count);
+    pending += count;
+    src += count;
+    len -= count;
+  }
+}
+
+void FileSink::writeString(const char * str)
+{
+  write(str, strlen(str));
+}
+
+void FileSink::print(const char * format, ...)
+{
+  char tmp[FILE_SINK_PRINT_BUFFER_SIZE];
+  va_list arglist;
+  va_start(arglist, format);
+  int len = vsnprintf(tmp, sizeof(tmp), format, arglist);
+  va_end(arglist);
+  if (len > 0) {
+    write(tmp, len < (int)sizeof(tmp) ? len : sizeof(tmp) - 1);
+  }
+}
+
+bool FileSink::commit()
+{
+  if (overflow || !isOpen()) {
+    if (overflow) {
+      stats.dropped += pending - head;
+      stats.overflows++;
+    }
+    pending = head;
+    overflow = false;
+    return false;
+  }
+
+  uint32_t used = pending - tail;
+  if (used > stats.maxUsed) {
+    stats.maxUsed = used;
+  }
+
+  // the data must be in the ring before the file sinks task sees it
+  __sync_synchronize();
+  head = pending;
+  return true;
+}
+
+void FileSink::resetStats()
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+// Writes the complete chunks, or all the committed data.
+// Called with the mutex held.
+void FileSink::flush(bool all)
+{
+  const uint32_t size = 2 * chunkSize;
+  const uint32_t end = head;
+
+  while (tail != end) {
+    // chunks never cross the end of the ring, as the ring offsets
+    // follow the file offsets
+    uint32_t chunkEnd = (tail / chunkSize + 1) * chunkSize;
+    if ((int32_t)(end - chunkEnd) < 0) {
+      if (!all) break;
+      chunkEnd = end;
+    }
+
+    uint32_t count = chunkEnd - tail;
+    UINT written;
+    if (f_write(file, &buffer[tail % size], count, &written) == FR_OK &&
+        written == count) {
+      stats.written += count;
+    }
+    else {
+      stats.writeErrors++;
+      error = true;
+    }
+    tail = chunkEnd;
+  }
+}
+
+void FileSink::wakeup()
+{
+  RTOS_LOCK_MUTEX(mutex);
+  if (isOpen()) {
+    bool sync = syncPeriod && (uint32_t)(RTOS_GET_MS() - lastSync) >= syncPeriod;
+    flush(sync);
+    if (sync) {
+      if (f_sync(file) != FR_OK) {
+        stats.writeErrors++;
+        error = true;
+      }
+      lastSync = RTOS_GET_MS();
+    }
+  }
+  RTOS_UNLOCK_MUTEX(mutex);
+}
+
+void fileSinksWakeup()
+{
+  for (FileSink * sink = fileSinks; sink; sink = sink->next) {
+    sink->wakeup();
+  }
+}
+
+#if !defined(SIMU)
+RTOS_TASK_HANDLE fileSinksTaskId;
+RTOS_DEFINE_STACK(fileSinksTaskId, fileSinksStack, FILE_SINKS_STACK_SIZE);
+
+TASK_FUNCTION(fileSinksTask)
+{
+  while (true) {
+    fileSinksWakeup();
+    RTOS_WAIT_MS(FILE_SINK_PERIOD_MS);
+  }
+
+  TASK_RETURN();
+}
+#endif
+
+void fileSinksInit()
+{
+  for (FileSink * sink = fileSinks; sink; sink = sink->next) {
+    sink->init();
+  }
+
+#if !defined(SIMU)
+  RTOS_CREATE_TASK(fileSinksTaskId, fileSinksTask, "file sinks",
+                   fileSinksStack, FILE_SINKS_STACK_SIZE, FILE_SINKS_TASK_PRIO);
+#endif
+}
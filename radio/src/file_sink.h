@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "ff.h"
+#include "rtos.h"
+
+// Write-behind file: the producer appends data to a RAM ring made of
+// two chunks, without ever waiting for the SD card. The file sinks task
+// writes the chunks once complete, aligned on the file sectors.
+//
+// Only one producer per sink: the data written since the last commit()
+// is added to the file all together, or dropped if the ring is full.
+
+#define FILE_SINK_PERIOD_MS   10
+
+struct FileSinkStats {
+  uint32_t written;       // bytes written to the file
+  uint32_t dropped;       // bytes dropped (ring full)
+  uint16_t overflows;     // number of commits dropped
+  uint16_t writeErrors;   // f_write() / f_sync() errors
+  uint16_t maxUsed;       // max bytes waiting in the ring
+};
+
+class FileSink
+{
+  public:
+    // 'buffer' must hold 2 chunks, chunkSize being a multiple of 512
+    FileSink(const char * name, FIL * file, uint8_t * buffer,
+             uint16_t chunkSize, uint16_t syncPeriodMs = 0);
+
+    const char * getName() const { return name; }
+
+    // creates the mutex, before the tasks are started
+    void init();
+
+    // Producer side
+    FRESULT open(const TCHAR * path, BYTE mode);
+    void close();
+
+    bool isOpen() const { return file->obj.fs != nullptr; }
+
+    // to be called again if the file pointer is moved
+    // before anything is written
+    void start();
+
+    void write(const void * data, uint32_t len);
+    void writeString(const char * str);
+    void print(const char * format, ...);
+    bool commit();
+
+    // the file sync period (0: the file is only synced when closed)
+    void setSyncPeriod(uint16_t ms) { syncPeriod = ms; }
+
+    // true if a write failed since the file was opened
+    bool hasError() const { return error; }
+
+    const FileSinkStats & getStats() const { return stats; }
+    void resetStats();
+
+    // File sinks task side
+    void wakeup();
+
+    FileSink * next;
+
+  protected:
+    const char * name;
+    FIL * file;
+    uint8_t * buffer;
+    uint16_t chunkSize;
+    uint16_t syncPeriod;
+    uint32_t lastSync;
+    RTOS_MUTEX_HANDLE mutex;
+
+    // file offsets of the ring contents
+    volatile uint32_t tail;  // next byte to write to the file
+    volatile uint32_t head;  // end of the committed data
+    uint32_t pending;        // end of the data waiting for commit()
+    bool overflow;
+    bool error;
+
+    FileSinkStats stats;
+
+    void flush(bool all);
+};
+
+// first of the registered sinks
+extern FileSink * fileSinks;
+
+// creates the sinks mutexes and the file sinks task
+void fileSinksInit();
+
+// writes the completed chunks of all the sinks (called by the
+// file sinks task, or by perMain() in the simulator)
+void fileSinksWakeup();
@@ -243,18 +243,14 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
                        mixerCurrentFlightMode);
             } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_GVAR) {
               SET_GVAR(CFN_GVAR_INDEX(cfn),
-                       GVAR_VALUE(CFN_PARAM(cfn),
-                                  getGVarFlightMode(mixerCurrentFlightMode,
-                                                    CFN_PARAM(cfn))),
+                       getGVarValue(CFN_PARAM(cfn), mixerCurrentFlightMode),
                        mixerCurrentFlightMode);
             } else if (CFN_GVAR_MODE(cfn) == FUNC_ADJUST_GVAR_INCDEC) {
               if (!(functionsContext.activeSwitches & switch_mask)) {
                 SET_GVAR(CFN_GVAR_INDEX(cfn),
                          limit<int16_t>(MODEL_GVAR_MIN(CFN_GVAR_INDEX(cfn)),
-                                        GVAR_VALUE(CFN_GVAR_INDEX(cfn),
-                                                   getGVarFlightMode(
-                                                       mixerCurrentFlightMode,
-                                                       CFN_GVAR_INDEX(cfn))) +
+                                        getGVarValue(CFN_GVAR_INDEX(cfn),
+                                                     mixerCurrentFlightMode) +
                                             CFN_PARAM(cfn),
                                         MODEL_GVAR_MAX(CFN_GVAR_INDEX(cfn))),
                          mixerCurrentFlightMode);
@@ -349,9 +345,7 @@ void evalFunctions(const CustomFunctionData * functions, CustomFunctionsContext
               } else {
 #if defined(GVARS)
                 if (CFN_FUNC(cfn) == FUNC_PLAY_TRACK && param > 250)
-                  param = GVAR_VALUE(
-                      param - 251,
-                      getGVarFlightMode(mixerCurrentFlightMode, param - 251));
+                  param = getGVarValue(param - 251, mixerCurrentFlightMode);
 #endif
                 PUSH_CUSTOM_PROMPT(active ? param : param + 1, PLAY_INDEX);
               }
@@ -137,6 +137,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      maxMixerFadeDuration = 0;
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -193,6 +194,11 @@ void menuStatisticsDebug(event_t event)
   lcdDrawText(lcdLastRightPos, y, "ms)");
   y += FH;
 
+  lcdDrawTextAlignedLeft(y, STR_TMIXFADEMAXMS);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(maxMixerFadeDuration), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
   lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, menusStack.available(), LEFT);
   lcdDrawText(lcdLastRightPos, y, "/");
@@ -132,6 +132,7 @@ void menuStatisticsDebug(event_t event)
       maxLuaDuration = 0;
 #endif
       maxMixerDuration  = 0;
+      maxMixerFadeDuration = 0;
       break;
 
     case EVT_KEY_FIRST(KEY_PLUS):
@@ -186,6 +187,11 @@ void menuStatisticsDebug(event_t event)
   lcdDrawText(lcdLastRightPos, y, STR_MS);
   y += FH;
 
+  lcdDrawTextAlignedLeft(y, STR_TMIXFADEMAXMS);
+  lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, DURATION_MS_PREC2(maxMixerFadeDuration), PREC2|LEFT);
+  lcdDrawText(lcdLastRightPos, y, STR_MS);
+  y += FH;
+
   lcdDrawTextAlignedLeft(y, STR_FREE_STACK);
   lcdDrawText(MENU_DEBUG_COL1_OFS, y+1, "[M]", SMLSIZE);
   lcdDrawNumber(lcdLastRightPos, y, menusStack.available(), LEFT);
@@ -517,6 +517,7 @@ class GVarEditWindow : public Page
             line, rect_t{}, [=] { return fmData->gvars[index] <= GVAR_MAX; },
             [=](uint8_t checked) {
               fmData->gvars[index] = checked ? 0 : GVAR_MAX + 1;
+              storageDirty(EE_MODEL);
               setProperties(flightMode);
             });
         lv_obj_set_style_grid_cell_x_align(cb->getLvObj(), LV_GRID_ALIGN_END,
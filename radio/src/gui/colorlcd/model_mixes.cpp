@@ -32,6 +32,7 @@
 #include "mixer_edit.h"
 #include "input_mapping.h"
 #include "mixes.h"
+#include "mixer_plan.h"
 
 #include "tasks/mixer_task.h"
 #include "hal/adc_driver.h"
@@ -130,6 +131,10 @@ MixLineButton::MixLineButton(Window* parent, uint8_t index) :
 {
   lv_obj_t* p_obj = parent->getLvObj();
   lv_obj_add_event_cb(p_obj, mix_draw_mplex, LV_EVENT_DRAW_PART_END, lvobj);
+
+  // source part of a feedback loop
+  lv_obj_set_style_text_color(source, makeLvColor(COLOR_THEME_WARNING),
+                              LV_STATE_USER_1);
 }
 
 void MixLineButton::deleteLater(bool detach, bool trash)
@@ -145,6 +150,12 @@ void MixLineButton::refresh()
   setWeight(line.weight, MIX_WEIGHT_MIN, MIX_WEIGHT_MAX);
   setSource(line.srcRaw);
 
+  if (isMixLineInLoop(index)) {
+    lv_obj_add_state(source, LV_STATE_USER_1);
+  } else {
+    lv_obj_clear_state(source, LV_STATE_USER_1);
+  }
+
   char tmp_str[64];
   size_t maxlen = sizeof(tmp_str);
 
@@ -308,14 +319,17 @@ void ModelMixesPage::editMix(uint8_t channel, uint8_t index)
   auto line = getLineByIndex(index);
   if (!line) return;
 
-  auto line_obj = line->getLvObj();
   auto edit = new MixEditWindow(channel, index);
   edit->setCloseHandler([=]() {
     MixData* mix = mixAddress(index);
     if (is_memclear(mix, sizeof(MixData))) {
       deleteMix(index);
     } else {
-      lv_event_send(line_obj, LV_EVENT_VALUE_CHANGED, nullptr);
+      // a new source may create or remove a feedback
+      // loop, which is shown on the other lines as well
+      for (auto l : lines) {
+        lv_event_send(l->getLvObj(), LV_EVENT_VALUE_CHANGED, nullptr);
+      }
     }
   });
 }
@@ -28,6 +28,7 @@
 #include "model_templates.h"
 #include "opentx.h"
 #include "standalone_lua.h"
+#include "thumbnail_cache.h"
 #include "view_channels.h"
 
 inline tmr10ms_t getTicks() { return g_tmr10ms; }
@@ -80,32 +81,12 @@ class ModelButton : public Button
                             ? COLOR_THEME_ACTIVE
                             : COLOR_THEME_PRIMARY2;
 
-    coord_t w = width() - 8;
-    coord_t h = height() - 8;
-
-    GET_FILENAME(filename, BITMAPS_PATH, modelCell->modelBitmap, "");
-    const BitmapBuffer *bitmap = BitmapBuffer::loadBitmap(filename);
-
-    if (bitmap) {
-      buffer = new BitmapBuffer(BMP_RGB565, w, h);
-      if (buffer) {
-        buffer->clear(bg_color);
-        buffer->drawScaledBitmap(bitmap, 0, 0, w, h);
-        delete bitmap;
-
-        lv_obj_t *bm = lv_canvas_create(lvobj);
-        lv_obj_center(bm);
-        lv_canvas_set_buffer(bm, buffer->getData(), buffer->width(),
-                             buffer->height(), LV_IMG_CF_TRUE_COLOR);
-      }
-    }
-
-    if (!buffer) {
-      std::string errorMsg = "(";
-      errorMsg += STR_NO_PICTURE;
-      errorMsg += ")";
-      new StaticText(this, {2, h / 2, w, 17}, errorMsg, 0,
-                     CENTERED | COLOR_THEME_SECONDARY1 | FONT(XS));
+    if (!modelCell->modelBitmap[0]) {
+      showNoPicture();
+    } else {
+      // the thumbnail is loaded once the button is visible
+      lv_obj_add_event_cb(lvobj, ModelButton::on_draw,
+                          LV_EVENT_DRAW_MAIN_BEGIN, nullptr);
     }
 
     auto name =
@@ -119,13 +100,60 @@ class ModelButton : public Button
     check(modelCell == modelslist.getCurrentModel());
   }
 
-  ~ModelButton()
+  // the thumbnail is released once the canvas using it is deleted, and
+  // not when the button is trashed, so that the page can free it
+  void deleteLater(bool detach = true, bool trash = true) override
+  {
+    if (_deleted) return;
+
+    Button::deleteLater(detach, trash);
+
+    if (buffer) {
+      thumbnailCache.release(buffer);
+      buffer = nullptr;
+    }
+  }
+
+  static void on_draw(lv_event_t *e)
+  {
+    lv_obj_t *target = lv_event_get_target(e);
+    auto button = (ModelButton *)lv_obj_get_user_data(target);
+    if (button && !button->loaded) button->delayed_init();
+  }
+
+  void delayed_init()
   {
+    loaded = true;
+
+    LcdFlags bg_color = modelCell == modelslist.getCurrentModel()
+                            ? COLOR_THEME_ACTIVE
+                            : COLOR_THEME_PRIMARY2;
+
+    buffer = thumbnailCache.get(modelCell->modelBitmap, width() - 8,
+                                height() - 8, bg_color);
     if (buffer) {
-      delete buffer;
+      lv_obj_t *bm = lv_canvas_create(lvobj);
+      lv_obj_center(bm);
+      lv_canvas_set_buffer(bm, buffer->getData(), buffer->width(),
+                           buffer->height(), LV_IMG_CF_TRUE_COLOR);
+      // keep the model name above the picture
+      lv_obj_move_background(bm);
+    } else {
+      showNoPicture();
     }
   }
 
+  void showNoPicture()
+  {
+    coord_t w = width() - 8;
+    coord_t h = height() - 8;
+    std::string errorMsg = "(";
+    errorMsg += STR_NO_PICTURE;
+    errorMsg += ")";
+    new StaticText(this, {2, h / 2, w, 17}, errorMsg, 0,
+                   CENTERED | COLOR_THEME_SECONDARY1 | FONT(XS));
+  }
+
   const char *modelFilename() { return modelCell->modelFilename; }
   ModelCell *getModelCell() const { return modelCell; }
 
@@ -141,7 +169,7 @@ class ModelButton : public Button
  protected:
   bool loaded = false;
   ModelCell *modelCell;
-  BitmapBuffer *buffer = nullptr;
+  const BitmapBuffer *buffer = nullptr;
   std::function<void()> m_setSelected = nullptr;
 
   void onClicked() override
@@ -487,6 +515,15 @@ ModelLabelsWindow::ModelLabelsWindow() : Page(ICON_MODEL)
   }
 }
 
+void ModelLabelsWindow::deleteLater(bool detach, bool trash)
+{
+  if (!deleted()) {
+    Page::deleteLater(detach, trash);
+    // the thumbnails are only needed while the models are shown
+    thumbnailCache.clear();
+  }
+}
+
 #if defined(HARDWARE_KEYS)
 void ModelLabelsWindow::onPressSYS()
 {
@@ -33,6 +33,8 @@ class ModelLabelsWindow : public Page
  public:
   ModelLabelsWindow();
 
+  void deleteLater(bool detach = true, bool trash = true) override;
+
  protected:
   ModelsSortBy sort = DEFAULT_MODEL_SORT;
   char tmpLabel[LABEL_LENGTH + 1] = "\0";
@@ -25,6 +25,7 @@
 #include "../../storage/yaml/yaml_tree_walker.h"
 #include "../../storage/yaml/yaml_bits.h"
 #include "../../storage/sdcard_common.h"
+#include "../../storage/sdcard_yaml.h"
 
 #define SET_DIRTY() storageDirty(EE_GENERAL)
 
@@ -34,11 +35,6 @@ constexpr const char *RGBSTRING = "RGB(";
 
 ThemePersistance themePersistance;
 
-// prototype for SD card function to read a YAML file
-// TODO: should this be in sdcard header file?
-enum class ChecksumResult;
-extern const char* readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx, ChecksumResult* checksum_result);
-
 static uint32_t r_color(const YamlNode* node, const char* val, uint8_t val_len)
 {
   if ((strncmp(val, RGBSTRING, strlen(RGBSTRING)) == 0) && (val[val_len - 1] == ')')) {
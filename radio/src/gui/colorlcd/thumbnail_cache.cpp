@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "thumbnail_cache.h"
+
+#include "opentx.h"
+
+#define THUMBNAIL_MAGIC    "ETXT"
+#define THUMBNAIL_VERSION  1
+
+PACK(struct ThumbnailHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t reserved;
+});
+
+ThumbnailCache thumbnailCache;
+
+// The file name only depends on the bitmap name and the thumbnail size and
+// color: the file is overwritten when the bitmap changes
+static void getThumbnailPath(char* path, const uint8_t* key, uint32_t len)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (uint32_t i = 0; i < len; i++) {
+    hash = (hash ^ key[i]) * 16777619u;
+  }
+  sprintf(path, THUMBNAILS_PATH PATH_SEPARATOR "%08X.thb", (unsigned)hash);
+}
+
+BitmapBuffer* ThumbnailCache::loadFile(const char* path, const Key& key)
+{
+  FIL file;
+  if (f_open(&file, path, FA_OPEN_EXISTING | FA_READ) != FR_OK) return nullptr;
+
+  ThumbnailHeader header;
+  Key fileKey;
+  UINT count;
+  BitmapBuffer* bitmap = nullptr;
+
+  if (f_read(&file, &header, sizeof(header), &count) == FR_OK &&
+      count == sizeof(header) &&
+      !memcmp(header.magic, THUMBNAIL_MAGIC, sizeof(header.magic)) &&
+      header.version == THUMBNAIL_VERSION &&
+      f_read(&file, &fileKey, sizeof(fileKey), &count) == FR_OK &&
+      count == sizeof(fileKey) && !memcmp(&fileKey, &key, sizeof(key))) {
+    bitmap = new BitmapBuffer(BMP_RGB565, key.width, key.height);
+    if (bitmap->getData() == nullptr ||
+        f_read(&file, bitmap->getData(), bitmap->getDataSize(), &count) != FR_OK ||
+        count != bitmap->getDataSize()) {
+      delete bitmap;
+      bitmap = nullptr;
+    }
+  }
+
+  f_close(&file);
+  return bitmap;
+}
+
+void ThumbnailCache::saveFile(const char* path, const Key& key,
+                              BitmapBuffer* bitmap)
+{
+  if (sdCheckAndCreateDirectory(THUMBNAILS_PATH) != nullptr) return;
+
+  FIL file;
+  if (f_open(&file, path, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK) return;
+
+  ThumbnailHeader header;
+  memcpy(header.magic, THUMBNAIL_MAGIC, sizeof(header.magic));
+  header.version = THUMBNAIL_VERSION;
+  header.reserved = 0;
+
+  UINT count;
+  bool ok = f_write(&file, &header, sizeof(header), &count) == FR_OK &&
+            f_write(&file, &key, sizeof(key), &count) == FR_OK &&
+            f_write(&file, bitmap->getData(), bitmap->getDataSize(), &count) == FR_OK &&
+            count == bitmap->getDataSize();
+  f_close(&file);
+
+  // don't leave a partial thumbnail
+  if (!ok) f_unlink(path);
+}
+
+const BitmapBuffer* ThumbnailCache::get(const char* bitmap, coord_t w,
+                                        coord_t h, LcdFlags bgColor)
+{
+  if (!bitmap[0]) return nullptr;
+
+  char filename[LEN_BITMAP_NAME + 1];
+  strAppend(filename, bitmap, LEN_BITMAP_NAME);
+  GET_FILENAME(path, BITMAPS_PATH, filename, "");
+
+  FILINFO fno;
+  if (f_stat(path, &fno) != FR_OK) return nullptr;
+
+  Key key;
+  memset(&key, 0, sizeof(key));
+  strncpy(key.bitmap, filename, LEN_BITMAP_NAME);
+  key.fsize = fno.fsize;
+  key.fdate = fno.fdate;
+  key.ftime = fno.ftime;
+  key.width = w;
+  key.height = h;
+  key.bgColor = COLOR_VAL(bgColor);
+
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (!memcmp(&it->key, &key, sizeof(key))) {
+      it->refs++;
+      entries.splice(entries.begin(), entries, it);
+      return it->bitmap;
+    }
+  }
+
+  // the source file info is not part of the thumbnail file name
+  char thumbnailPath[sizeof(THUMBNAILS_PATH) + 16];
+  getThumbnailPath(thumbnailPath, (const uint8_t*)&key, offsetof(Key, fsize));
+
+  BitmapBuffer* thumbnail = loadFile(thumbnailPath, key);
+  if (!thumbnail) {
+    const BitmapBuffer* source = BitmapBuffer::loadBitmap(path);
+    if (!source) return nullptr;
+
+    thumbnail = new BitmapBuffer(BMP_RGB565, w, h);
+    if (thumbnail->getData() == nullptr) {
+      delete source;
+      delete thumbnail;
+      return nullptr;
+    }
+    thumbnail->clear(bgColor);
+    thumbnail->drawScaledBitmap(source, 0, 0, w, h);
+    delete source;
+
+    saveFile(thumbnailPath, key, thumbnail);
+  }
+
+  entries.push_front({key, thumbnail, 1});
+  size += thumbnail->getDataSize();
+  trim(THUMBNAILS_RAM_SIZE);
+
+  return thumbnail;
+}
+
+void ThumbnailCache::release(const BitmapBuffer* thumbnail)
+{
+  for (auto& entry : entries) {
+    if (entry.bitmap == thumbnail) {
+      if (entry.refs > 0) entry.refs--;
+      break;
+    }
+  }
+  trim(THUMBNAILS_RAM_SIZE);
+}
+
+void ThumbnailCache::clear() { trim(0); }
+
+// frees the least recently used thumbnails which are not used anymore
+void ThumbnailCache::trim(uint32_t maxSize)
+{
+  for (auto it = entries.end(); size > maxSize && it != entries.begin();) {
+    --it;
+    if (it->refs == 0) {
+      size -= it->bitmap->getDataSize();
+      delete it->bitmap;
+      it = entries.erase(it);
+    }
+  }
+}
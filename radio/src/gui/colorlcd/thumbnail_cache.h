@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <list>
+
+#include "bitmapbuffer.h"
+#include "dataconstants.h"
+
+// Pre-scaled RGB565 thumbnails of the /IMAGES bitmaps, drawn over their
+// background color. They are stored in /IMAGES/.cache, so that the full
+// size images are only decoded once, and the unused ones are kept in RAM
+// up to THUMBNAILS_RAM_SIZE.
+
+#define THUMBNAILS_PATH       BITMAPS_PATH PATH_SEPARATOR ".cache"
+#define THUMBNAILS_RAM_SIZE   (256 * 1024)
+
+class ThumbnailCache
+{
+ public:
+  // Returns the thumbnail, or nullptr if the bitmap can't be loaded.
+  // release() must be called when it is not used anymore.
+  const BitmapBuffer* get(const char* bitmap, coord_t w, coord_t h,
+                          LcdFlags bgColor);
+  void release(const BitmapBuffer* thumbnail);
+
+  // frees all the unused thumbnails
+  void clear();
+
+ protected:
+  PACK(struct Key {
+    char bitmap[LEN_BITMAP_NAME];
+    uint16_t width;
+    uint16_t height;
+    uint16_t bgColor;
+    uint32_t fsize;  // source file info, to detect changes
+    uint16_t fdate;
+    uint16_t ftime;
+  });
+
+  struct Entry {
+    Key key;
+    BitmapBuffer* bitmap;
+    uint16_t refs;
+  };
+
+  // most recently used first
+  std::list<Entry> entries;
+  uint32_t size = 0;
+
+  BitmapBuffer* loadFile(const char* path, const Key& key);
+  void saveFile(const char* path, const Key& key, BitmapBuffer* bitmap);
+  void trim(uint32_t maxSize);
+};
+
+extern ThumbnailCache thumbnailCache;
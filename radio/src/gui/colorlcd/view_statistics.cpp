@@ -261,6 +261,15 @@ void DebugViewPage::build(FormWindow* window)
   line = form->newLine(&grid);
   line->padAll(2);
 
+  // Mixer during flight mode fades
+  new StaticText(line, rect_t{}, STR_TMIXFADEMAXMS, 0, COLOR_THEME_PRIMARY1);
+  new DynamicNumber<uint16_t>(
+      line, rect_t{}, [] { return DURATION_MS_PREC2(maxMixerFadeDuration); },
+      PREC2 | COLOR_THEME_PRIMARY1, nullptr, pad_STR_MS.c_str());
+
+  line = form->newLine(&grid);
+  line->padAll(2);
+
   // Free mem
   static std::string pad_STR_BYTES = " " + std::string(STR_BYTES);
   new StaticText(line, rect_t{}, STR_FREE_MEM_LABEL, 0, COLOR_THEME_PRIMARY1);
@@ -387,6 +396,7 @@ void DebugViewPage::build(FormWindow* window)
   auto btn = new TextButton(line, rect_t{0, 0, 0, 24}, STR_MENUTORESET,
                             [=]() -> uint8_t {
                               maxMixerDuration = 0;
+                              maxMixerFadeDuration = 0;
 #if defined(LUA)
                               maxLuaInterval = 0;
                               maxLuaDuration = 0;
@@ -24,6 +24,7 @@
 #include "hal/adc_driver.h"
 #include "input_mapping.h"
 #include "mixes.h"
+#include "mixer_plan.h"
 
 #define _STR_MAX(x)                     "/" #x
 #define STR_MAX(x)                     _STR_MAX(x)
@@ -346,7 +347,8 @@ void menuModelMixAll(event_t event)
 
           if (mixCnt > 0) lcdDrawTextAtIndex(FW, y, STR_VMLTPX2, md->mltpx, 0);
 
-          drawSource(MIX_LINE_SRC_POS, y, md->srcRaw, 0);
+          // blink when the source is part of a feedback loop
+          drawSource(MIX_LINE_SRC_POS, y, md->srcRaw, isMixLineInLoop(i) ? BLINK : 0);
 
           if (mixCnt == 0 && md->mltpx == 1) {
             lcdDrawText(MIX_LINE_WEIGHT_POS, y, "MULT!", RIGHT | attr | (isMixActive(i) ? BOLD : 0));
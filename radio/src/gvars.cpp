@@ -37,6 +37,46 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+// GVars values resolved for each flight mode ("use value from FMx" followed)
+static gvar_t _gvars_values[MAX_FLIGHT_MODES][MAX_GVARS];
+
+// the cache is valid when both serials are the same
+static volatile uint8_t _gvars_serial = 1;
+static uint8_t _gvars_cache_serial = 0;
+
+void gvarsCacheInvalidate()
+{
+  _gvars_serial++;
+}
+
+static void gvarsCacheUpdate()
+{
+#if defined(SIMU)
+  if (modelCachesAlwaysRebuild) gvarsCacheInvalidate();
+#endif
+
+  uint8_t serial = _gvars_serial;
+  if (serial == _gvars_cache_serial)
+    return;
+
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv=0; gv<MAX_GVARS; gv++) {
+      _gvars_values[fm][gv] = GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
+    }
+  }
+
+  _gvars_cache_serial = serial;
+}
+
+static gvar_t getGVarResolvedValue(uint8_t gv, uint8_t fm)
+{
+  if (fm >= MAX_FLIGHT_MODES)
+    return GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
+
+  gvarsCacheUpdate();
+  return _gvars_values[fm][gv];
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
@@ -44,7 +84,7 @@ int16_t getGVarValue(int8_t gv, int8_t fm)
     gv = -1-gv;
     mul = -1;
   }
-  return GVAR_VALUE(gv, getGVarFlightMode(fm, gv)) * mul;
+  return getGVarResolvedValue(gv, fm) * mul;
 }
 
 int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
@@ -54,7 +94,7 @@ int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
   if (gv < 0) {
     mul = -mul;
   }
-  return GVAR_VALUE(idx, getGVarFlightMode(fm, idx)) * mul;
+  return getGVarResolvedValue(idx, fm) * mul;
 }
 
 void setGVarValue(uint8_t gv, int16_t value, int8_t fm)
@@ -38,6 +38,9 @@
     int16_t getGVarValue(int8_t gv, int8_t fm);
     int32_t getGVarValuePrec1(int8_t gv, int8_t fm);
     void setGVarValue(uint8_t x, int16_t value, int8_t fm);
+    // The values resolved for each flight mode are cached: the cache
+    // is invalidated by storageDirty(EE_MODEL), so by SET_GVAR_VALUE()
+    void gvarsCacheInvalidate();
     #define GET_GVAR(x, min, max, fm)  getGVarFieldValue(x, min, max, fm)
     #define SET_GVAR(idx, val, fm)     setGVarValue(idx, val, fm)
     #define GVAR_DISPLAY_TIME          100 /*1 second*/;
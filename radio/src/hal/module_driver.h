@@ -56,6 +56,10 @@ struct etx_proto_driver_t {
     // Process input data byte (telemetry)
     void (*processData)(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* len);
 
+    // Process input data bytes (telemetry), optional: same as calling
+    // processData() for each byte
+    void (*processBuffer)(void* ctx, const uint8_t* data, uint32_t size, uint8_t* buffer, uint8_t* len);
+
     // Process input data byte (telemetry)
     void (*processFrame)(void* ctx, uint8_t* frame, uint8_t flen, uint8_t* buf, uint8_t* len);
 
@@ -99,6 +99,14 @@ typedef struct {
 
   int (*copyRxBuffer)(void* ctx, uint8_t* buf, uint32_t len);
 
+  // Get the unread bytes which are contiguous in the internal buffer,
+  // without copying them: returns their number. They stay in the buffer
+  // until released with consumeBuffer()
+  int (*getBuffer)(void* ctx, const uint8_t** data);
+
+  // Release the first 'len' bytes returned by getBuffer()
+  void (*consumeBuffer)(void* ctx, uint32_t len);
+
   // Clear internal buffer
   void (*clearRxBuffer)(void* ctx);
 
@@ -31,7 +31,26 @@
   #include "libopenui.h"
 #endif
 
+#include "file_sink.h"
+
+#if defined(LOGS_BINARY)
+  #include "logs_binary.h"
+  #include "crc.h"
+#endif
+
+#if defined(COLORLCD)
+  #define LOGS_CHUNK_SIZE      4096
+#else
+  #define LOGS_CHUNK_SIZE      1024
+#endif
+
+#define LOGS_SYNC_PERIOD_MS    2000
+
 FIL g_oLogFile __DMA;
+static uint8_t _logs_sink_buffer[2 * LOGS_CHUNK_SIZE] __DMA;
+FileSink logsSink("logs", &g_oLogFile, _logs_sink_buffer, LOGS_CHUNK_SIZE,
+                  LOGS_SYNC_PERIOD_MS);
+
 uint8_t logDelay100ms;
 static tmr10ms_t lastLogTime = 0;
 
@@ -100,13 +119,338 @@ void initLoggingTimer() {                                       // called cyclic
 }
 #endif
 
+#if !defined(LOGS_BINARY)
 void writeHeader();
+#endif
 
 int getSwitchState(uint8_t swtch) {
   int value = getValue(MIXSRC_FIRST_SWITCH + swtch);
   return (value == 0) ? 0 : (value < 0) ? -1 : +1;
 }
 
+#if defined(LOGS_BINARY)
+uint32_t getLogicalSwitchesStates(uint8_t first);
+
+#define LOGS_NAME_LEN        8
+
+// The units are written in full, the longest one of the translated
+// units table (UTF-8) gives the size of the columns descriptions buffer
+static constexpr const char * const logsUnits[] = { TR_VTELEMUNIT };
+
+static constexpr size_t logsStrLen(const char * str)
+{
+  return *str ? 1 + logsStrLen(str + 1) : 0;
+}
+
+static constexpr size_t logsMaxStrLen(const char * const * strs, size_t count,
+                                      size_t len = 0)
+{
+  return count == 0 ? len
+                    : logsMaxStrLen(strs + 1, count - 1,
+                                    logsStrLen(strs[0]) > len
+                                        ? logsStrLen(strs[0])
+                                        : len);
+}
+
+#define LOGS_UNIT_LEN        logsMaxStrLen(logsUnits, DIM(logsUnits))
+
+static_assert(LOGS_UNIT_LEN >= 2, "\"us\" and \"V\" units must fit");
+
+#define LOGS_MAX_COLUMNS                                            \
+  (MAX_TELEMETRY_SENSORS + MAX_STICKS + MAX_POTS + MAX_SWITCHES + \
+   MAX_OUTPUT_CHANNELS + 3)
+
+enum LogsColumnSource {
+  LOGS_SRC_TIME,
+  LOGS_SRC_SENSOR,
+  LOGS_SRC_MAIN_INPUT,
+  LOGS_SRC_FLEX_INPUT,
+  LOGS_SRC_SWITCH,
+  LOGS_SRC_LOGICAL_SWITCHES,
+  LOGS_SRC_CHANNEL,
+  LOGS_SRC_TX_VOLTAGE,
+};
+
+struct LogsColumn {
+  uint8_t source;  // LogsColumnSource
+  uint8_t index;
+  uint8_t type;    // LogsBinaryColumnType
+  uint8_t size;
+};
+
+// The columns are chosen when the file is opened: all the records
+// keep the layout announced in the header, even if the model changes.
+static LogsColumn _logs_columns[LOGS_MAX_COLUMNS];
+static uint8_t _logs_columns_count;
+static uint16_t _logs_record_size;
+static uint16_t _logs_header_size;
+
+static void logsPut(const void * data, uint16_t len)
+{
+  logsSink.write(data, len);
+}
+
+// values are stored little endian, as in memory
+static void logsPutValue(int32_t value, uint8_t size)
+{
+  logsPut(&value, size);
+}
+
+static void logsAddColumn(uint8_t source, uint8_t index, uint8_t type,
+                          uint8_t size)
+{
+  _logs_columns[_logs_columns_count++] = {source, index, type, size};
+  _logs_record_size += size;
+}
+
+static void logsInitColumns()
+{
+  _logs_columns_count = 0;
+  _logs_record_size = 0;
+
+#if defined(RTCLOCK)
+  logsAddColumn(LOGS_SRC_TIME, 0, LOGS_COLUMN_RTC, 5);
+#else
+  logsAddColumn(LOGS_SRC_TIME, 0, LOGS_COLUMN_TIME, 4);
+#endif
+
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (isTelemetryFieldAvailable(i)) {
+      TelemetrySensor & sensor = g_model.telemetrySensors[i];
+      if (sensor.logs) {
+        if (sensor.unit == UNIT_GPS)
+          logsAddColumn(LOGS_SRC_SENSOR, i, LOGS_COLUMN_GPS, 8);
+        else if (sensor.unit == UNIT_DATETIME)
+          logsAddColumn(LOGS_SRC_SENSOR, i, LOGS_COLUMN_DATETIME, 7);
+        else if (sensor.unit == UNIT_TEXT)
+          logsAddColumn(LOGS_SRC_SENSOR, i, LOGS_COLUMN_TEXT,
+                        TELEMETRY_SENSOR_TEXT_LENGTH);
+        else
+          logsAddColumn(LOGS_SRC_SENSOR, i, LOGS_COLUMN_VALUE, 4);
+      }
+    }
+  }
+
+  auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    logsAddColumn(LOGS_SRC_MAIN_INPUT, i, LOGS_COLUMN_VALUE, 2);
+  }
+
+  n_inputs = adcGetMaxInputs(ADC_INPUT_FLEX);
+  for (uint8_t i = 0; i < n_inputs; i++) {
+    if (IS_POT_AVAILABLE(i))
+      logsAddColumn(LOGS_SRC_FLEX_INPUT, i, LOGS_COLUMN_VALUE, 2);
+  }
+
+  for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
+    if (SWITCH_EXISTS(i))
+      logsAddColumn(LOGS_SRC_SWITCH, i, LOGS_COLUMN_VALUE, 1);
+  }
+
+  logsAddColumn(LOGS_SRC_LOGICAL_SWITCHES, 0, LOGS_COLUMN_HEX, 8);
+
+  for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
+    logsAddColumn(LOGS_SRC_CHANNEL, channel, LOGS_COLUMN_VALUE, 2);
+  }
+
+  logsAddColumn(LOGS_SRC_TX_VOLTAGE, 0, LOGS_COLUMN_VALUE, 2);
+}
+
+// Computes the columns descriptions size and CRC, and writes them
+// if 'write' is set
+static uint16_t logsWriteColumns(bool write)
+{
+  uint16_t crc = 0;
+  _logs_header_size = LOGS_BINARY_PREAMBLE_SIZE;
+
+  for (uint8_t i = 0; i < _logs_columns_count; i++) {
+    const LogsColumn & column = _logs_columns[i];
+    // type, size, prec, name, unit
+    char desc[3 + LOGS_NAME_LEN + 1 + LOGS_UNIT_LEN + 1];
+    uint8_t prec = 0;
+    const char * unit = "";
+    char * name = &desc[3];
+
+    switch (column.source) {
+      case LOGS_SRC_TIME:
+        strcpy(name, "Time");
+        break;
+
+      case LOGS_SRC_SENSOR: {
+        TelemetrySensor & sensor = g_model.telemetrySensors[column.index];
+        strAppend(name, sensor.label, TELEM_LABEL_LEN);
+        uint8_t unitIndex = sensor.unit;
+        if (unitIndex == UNIT_CELLS) unitIndex = UNIT_VOLTS;
+        if (UNIT_RAW < unitIndex && unitIndex < UNIT_FIRST_VIRTUAL)
+          unit = STR_VTELEMUNIT[unitIndex];
+        if (column.type == LOGS_COLUMN_VALUE) prec = sensor.prec;
+        break;
+      }
+
+      case LOGS_SRC_MAIN_INPUT:
+        strAppend(name, analogGetCanonicalName(ADC_INPUT_MAIN, column.index),
+                  LOGS_NAME_LEN);
+        break;
+
+      case LOGS_SRC_FLEX_INPUT:
+        strAppend(name, analogGetCanonicalName(ADC_INPUT_FLEX, column.index),
+                  LOGS_NAME_LEN);
+        break;
+
+      case LOGS_SRC_SWITCH:
+        getSwitchName(name, column.index);
+        break;
+
+      case LOGS_SRC_LOGICAL_SWITCHES:
+        strcpy(name, "LSW");
+        break;
+
+      case LOGS_SRC_CHANNEL:
+        strAppendUnsigned(strAppend(name, "CH"), column.index + 1);
+        unit = "us";
+        break;
+
+      case LOGS_SRC_TX_VOLTAGE:
+        strcpy(name, "TxBat");
+        unit = "V";
+        prec = 1;
+        break;
+    }
+
+    desc[0] = column.type;
+    desc[1] = column.size;
+    desc[2] = prec;
+    char * end = strAppend(name + strlen(name) + 1, unit, LOGS_UNIT_LEN);
+    uint16_t len = end + 1 - desc;
+
+    crc = crc16(CRC_1021, (const uint8_t *)desc, len, crc);
+    _logs_header_size += len;
+    if (write) logsPut(desc, len);
+  }
+
+  return crc;
+}
+
+static const char * logsBinaryOpen()
+{
+  logsInitColumns();
+
+  uint16_t crc = logsWriteColumns(false);
+  uint8_t preamble[LOGS_BINARY_PREAMBLE_SIZE];
+  memcpy(preamble, LOGS_BINARY_MAGIC, 4);
+  preamble[4] = LOGS_BINARY_VERSION;
+  preamble[5] = 0;
+  uint16_t values[] = { _logs_columns_count, _logs_record_size,
+                        _logs_header_size, crc };
+  memcpy(&preamble[6], values, sizeof(values));
+
+  FSIZE_t size = f_size(&g_oLogFile);
+  if (size > 0) {
+    uint8_t existing[LOGS_BINARY_PREAMBLE_SIZE];
+    UINT read;
+    if (size >= _logs_header_size &&
+        f_read(&g_oLogFile, existing, sizeof(existing), &read) == FR_OK &&
+        read == sizeof(existing) && !memcmp(existing, preamble, sizeof(preamble))) {
+      // same columns: append after the last complete record
+      size -= (size - _logs_header_size) % _logs_record_size;
+    }
+    else {
+      // same file name with other columns (radios without RTC):
+      // the file is started again
+      size = 0;
+    }
+    FRESULT result = f_lseek(&g_oLogFile, size);
+    if (result == FR_OK) result = f_truncate(&g_oLogFile);
+    if (result != FR_OK) {
+      logsClose();
+      return SDCARD_ERROR(result);
+    }
+  }
+
+  logsSink.start();
+
+  if (size == 0) {
+    logsPut(preamble, sizeof(preamble));
+    logsWriteColumns(true);
+    if (!logsSink.commit()) {
+      logsClose();
+      return STR_SDCARD_ERROR;
+    }
+  }
+
+  return nullptr;
+}
+
+static void logsWriteRecord()
+{
+  for (uint8_t i = 0; i < _logs_columns_count; i++) {
+    const LogsColumn & column = _logs_columns[i];
+    switch (column.source) {
+      case LOGS_SRC_TIME:
+#if defined(RTCLOCK)
+        logsPutValue(g_rtcTime, 4);
+        logsPutValue(g_ms100, 1);
+#else
+        logsPutValue(get_tmr10ms(), 4);
+#endif
+        break;
+
+      case LOGS_SRC_SENSOR: {
+        TelemetryItem & telemetryItem = telemetryItems[column.index];
+        if (column.type == LOGS_COLUMN_GPS) {
+          logsPutValue(telemetryItem.gps.latitude, 4);
+          logsPutValue(telemetryItem.gps.longitude, 4);
+        }
+        else if (column.type == LOGS_COLUMN_DATETIME) {
+          logsPutValue(telemetryItem.datetime.year, 2);
+          logsPutValue(telemetryItem.datetime.month, 1);
+          logsPutValue(telemetryItem.datetime.day, 1);
+          logsPutValue(telemetryItem.datetime.hour, 1);
+          logsPutValue(telemetryItem.datetime.min, 1);
+          logsPutValue(telemetryItem.datetime.sec, 1);
+        }
+        else if (column.type == LOGS_COLUMN_TEXT) {
+          logsPut(telemetryItem.text, TELEMETRY_SENSOR_TEXT_LENGTH);
+        }
+        else {
+          logsPutValue(telemetryItem.value, 4);
+        }
+        break;
+      }
+
+      case LOGS_SRC_MAIN_INPUT: {
+        auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
+        logsPutValue(calibratedAnalogs[inputMappingConvertMode(offset + column.index)], 2);
+        break;
+      }
+
+      case LOGS_SRC_FLEX_INPUT:
+        logsPutValue(calibratedAnalogs[adcGetInputOffset(ADC_INPUT_FLEX) + column.index], 2);
+        break;
+
+      case LOGS_SRC_SWITCH:
+        logsPutValue(getSwitchState(column.index), 1);
+        break;
+
+      case LOGS_SRC_LOGICAL_SWITCHES: {
+        uint32_t states[] = { getLogicalSwitchesStates(0),
+                              getLogicalSwitchesStates(32) };
+        logsPut(states, sizeof(states));
+        break;
+      }
+
+      case LOGS_SRC_CHANNEL:
+        logsPutValue(PPM_CENTER + channelOutputs[column.index] / 2, 2); // in us
+        break;
+
+      case LOGS_SRC_TX_VOLTAGE:
+        logsPutValue(g_vbat100mV, 2);
+        break;
+    }
+  }
+}
+#endif
+
 void logsInit()
 {
   memset(&g_oLogFile, 0, sizeof(g_oLogFile));
@@ -118,7 +462,7 @@ const char * logsOpen()
   FRESULT result;
 
   // /LOGS/modelnamexxxxxx_YYYY-MM-DD-HHMMSS.log
-  char filename[sizeof(LOGS_PATH) + LEN_MODEL_NAME + 18 + 4 + 1];
+  char filename[sizeof(LOGS_PATH) + LEN_MODEL_NAME + 18 + sizeof(LOGS_EXT)];
 
   if (!sdMounted())
     return STR_NO_SDCARD;
@@ -167,36 +511,47 @@ const char * logsOpen()
 
   strcpy(tmp, STR_LOGS_EXT);
 
-  result = f_open(&g_oLogFile, filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
+#if defined(LOGS_BINARY)
+  result = logsSink.open(filename, FA_OPEN_ALWAYS | FA_WRITE | FA_READ);
+  if (result != FR_OK) {
+    return SDCARD_ERROR(result);
+  }
+
+  return logsBinaryOpen();
+#else
+  result = logsSink.open(filename, FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
 
   if (f_size(&g_oLogFile) == 0) {
     writeHeader();
+    if (!logsSink.commit()) {
+      logsClose();
+      return STR_SDCARD_ERROR;
+    }
   }
 
   return nullptr;
+#endif
 }
 
 void logsClose()
 {
-  if (g_oLogFile.obj.fs && sdMounted()) {
-    if (f_close(&g_oLogFile) != FR_OK) {
-      // close failed, forget file
-      g_oLogFile.obj.fs = 0;
-    }
+  if (logsSink.isOpen() && sdMounted()) {
+    logsSink.close();
     lastLogTime = 0;
   }
 
 }
 
+#if !defined(LOGS_BINARY)
 void writeHeader()
 {
 #if defined(RTCLOCK)
-  f_puts("Date,Time,", &g_oLogFile);
+  logsSink.writeString("Date,Time,");
 #else
-  f_puts("Time,", &g_oLogFile);
+  logsSink.writeString("Time,");
 #endif
 
 
@@ -215,7 +570,7 @@ void writeHeader()
           strcat(label, ")");
         }
         strcat(label, ",");
-        f_puts(label, &g_oLogFile);
+        logsSink.writeString(label);
       }
     }
   }
@@ -223,16 +578,16 @@ void writeHeader()
   auto n_inputs = adcGetMaxInputs(ADC_INPUT_MAIN);
   for (uint8_t i = 0; i < n_inputs; i++) {
     const char* p = analogGetCanonicalName(ADC_INPUT_MAIN, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+    logsSink.writeString(p);
+    logsSink.write(",", 1);
   }
 
   n_inputs = adcGetMaxInputs(ADC_INPUT_FLEX);
   for (uint8_t i = 0; i < n_inputs; i++) {
     if (!IS_POT_AVAILABLE(i)) continue;
     const char* p = analogGetCanonicalName(ADC_INPUT_FLEX, i);
-    while (*p) { f_putc(*(p++), &g_oLogFile); }
-    f_putc(',', &g_oLogFile);
+    logsSink.writeString(p);
+    logsSink.write(",", 1);
   }
 
   for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
@@ -242,17 +597,18 @@ void writeHeader()
       temp = getSwitchName(s, i);
       *temp++ = ',';
       *temp = '\0';
-      f_puts(s, &g_oLogFile);
+      logsSink.writeString(s);
     }
   }
-  f_puts("LSW,", &g_oLogFile);
+  logsSink.writeString("LSW,");
   
   for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-    f_printf(&g_oLogFile, "CH%d(us),", channel+1);
+    logsSink.print("CH%d(us),", channel+1);
   }
 
-  f_puts("TxBat(V)\n", &g_oLogFile);
+  logsSink.writeString("TxBat(V)\n");
 }
+#endif
 
 uint32_t getLogicalSwitchesStates(uint8_t first)
 {
@@ -283,7 +639,7 @@ void logsWrite()
       bool sdCardFull = sdIsFull();
 
       // check if file needs to be opened
-      if (!g_oLogFile.obj.fs) {
+      if (!logsSink.isOpen()) {
         const char *result = sdCardFull ? STR_SDCARD_FULL_EXT : logsOpen();
 
         // SD card is full or file open failed
@@ -304,7 +660,16 @@ void logsWrite()
         return;
       }
 
+#if defined(LOGS_BINARY)
+      logsWriteRecord();
+      logsSink.commit();
 
+      if (logsSink.hasError() && !error_displayed) {
+        error_displayed = STR_SDCARD_ERROR;
+        POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
+        logsClose();
+      }
+#else
 #if defined(RTCLOCK)
       {
         static struct gtm utm;
@@ -313,10 +678,10 @@ void logsWrite()
           lastRtcTime = g_rtcTime;
           gettime(&utm);
         }
-        f_printf(&g_oLogFile, "%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+        logsSink.print("%4d-%02d-%02d,%02d:%02d:%02d.%02d0,", utm.tm_year+TM_YEAR_BASE, utm.tm_mon+1, utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
       }
 #else
-      f_printf(&g_oLogFile, "%d,", tmr10ms);
+      logsSink.print("%d,", tmr10ms);
 #endif
 
       for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
@@ -327,34 +692,34 @@ void logsWrite()
             if (sensor.unit == UNIT_GPS) {
               if (telemetryItem.gps.longitude && telemetryItem.gps.latitude) {
                 div_t qr = div((int)telemetryItem.gps.latitude, 1000000);
-                if (telemetryItem.gps.latitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d ", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.latitude < 0) logsSink.print("-");
+                logsSink.print("%d.%06d ", abs(qr.quot), abs(qr.rem));
                 qr = div((int)telemetryItem.gps.longitude, 1000000);
-                if (telemetryItem.gps.longitude < 0) f_printf(&g_oLogFile, "-");
-                f_printf(&g_oLogFile, "%d.%06d,", abs(qr.quot), abs(qr.rem));
+                if (telemetryItem.gps.longitude < 0) logsSink.print("-");
+                logsSink.print("%d.%06d,", abs(qr.quot), abs(qr.rem));
               }
               else {
-                f_printf(&g_oLogFile, ",");
+                logsSink.print(",");
               }
             }
             else if (sensor.unit == UNIT_DATETIME) {
-              f_printf(&g_oLogFile, "%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
+              logsSink.print("%4d-%02d-%02d %02d:%02d:%02d,", telemetryItem.datetime.year, telemetryItem.datetime.month, telemetryItem.datetime.day, telemetryItem.datetime.hour, telemetryItem.datetime.min, telemetryItem.datetime.sec);
             }
             else if (sensor.unit == UNIT_TEXT) {
-              f_printf(&g_oLogFile, "\"%s\",", telemetryItem.text);
+              logsSink.print("\"%s\",", telemetryItem.text);
             }
             else if (sensor.prec == 2) {
               div_t qr = div((int)telemetryItem.value, 100);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%02d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) logsSink.print("-");
+              logsSink.print("%d.%02d,", abs(qr.quot), abs(qr.rem));
             }
             else if (sensor.prec == 1) {
               div_t qr = div((int)telemetryItem.value, 10);
-              if (telemetryItem.value < 0) f_printf(&g_oLogFile, "-");
-              f_printf(&g_oLogFile, "%d.%d,", abs(qr.quot), abs(qr.rem));
+              if (telemetryItem.value < 0) logsSink.print("-");
+              logsSink.print("%d.%d,", abs(qr.quot), abs(qr.rem));
             }
             else {
-              f_printf(&g_oLogFile, "%d,", telemetryItem.value);
+              logsSink.print("%d,", telemetryItem.value);
             }
           }
         }
@@ -364,7 +729,7 @@ void logsWrite()
       auto offset = adcGetInputOffset(ADC_INPUT_MAIN);
 
       for (uint8_t i = 0; i < n_inputs; i++) {
-        f_printf(&g_oLogFile, "%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
+        logsSink.print("%d,", calibratedAnalogs[inputMappingConvertMode(offset + i)]);
       }
 
       n_inputs = adcGetMaxInputs(ADC_INPUT_FLEX);
@@ -372,29 +737,31 @@ void logsWrite()
 
       for (uint8_t i = 0; i < n_inputs; i++) {
         if (IS_POT_AVAILABLE(i))
-          f_printf(&g_oLogFile, "%d,", calibratedAnalogs[offset + i]);
+          logsSink.print("%d,", calibratedAnalogs[offset + i]);
       }
 
       for (uint8_t i = 0; i < switchGetMaxSwitches(); i++) {
         if (SWITCH_EXISTS(i)) {
-          f_printf(&g_oLogFile, "%d,", getSwitchState(i));
+          logsSink.print("%d,", getSwitchState(i));
         }
       }
-      f_printf(&g_oLogFile, "0x%08X%08X,", getLogicalSwitchesStates(32),
+      logsSink.print("0x%08X%08X,", getLogicalSwitchesStates(32),
                getLogicalSwitchesStates(0));
 
       for (uint8_t channel = 0; channel < MAX_OUTPUT_CHANNELS; channel++) {
-        f_printf(&g_oLogFile, "%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
+        logsSink.print("%d,", PPM_CENTER+channelOutputs[channel]/2); // in us
       }
 
       div_t qr = div(g_vbat100mV, 10);
-      int result = f_printf(&g_oLogFile, "%d.%d\n", abs(qr.quot), abs(qr.rem));
+      logsSink.print("%d.%d\n", abs(qr.quot), abs(qr.rem));
+      logsSink.commit();
 
-      if (result<0 && !error_displayed) {
+      if (logsSink.hasError() && !error_displayed) {
         error_displayed = STR_SDCARD_ERROR;
         POPUP_WARNING_ON_UI_TASK(STR_SDCARD_ERROR, nullptr, false);
         logsClose();
       }
+#endif
     }
   }
   else {
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+// Binary flight logs format, also read by Companion and
+// radio/util/log2csv.py. All values are little endian.
+//
+// The format is chosen at build time with the LOGS_BINARY option (OFF by
+// default): there is no radio setting, the firmware writes either CSV or
+// binary logs.
+//
+// Header:
+//   char     magic[4]       LOGS_BINARY_MAGIC
+//   uint8_t  version        LOGS_BINARY_VERSION
+//   uint8_t  reserved
+//   uint16_t columnsCount
+//   uint16_t recordSize     size of each record
+//   uint16_t headerSize     size of the whole header, records follow it
+//   uint16_t columnsCrc     crc16 (CRC_1021) of the columns descriptions
+//
+// Then one description per column:
+//   uint8_t  type           LogsBinaryColumnType
+//   uint8_t  size           size of the column value in each record
+//   uint8_t  prec           number of decimals (LOGS_COLUMN_VALUE)
+//   char     name[]         '\0' terminated
+//   char     unit[]         '\0' terminated, may be empty
+//
+// Then the records: the values of all the columns, in the same order.
+
+#define LOGS_BINARY_MAGIC              "ETXL"
+#define LOGS_BINARY_VERSION            1
+#define LOGS_BINARY_PREAMBLE_SIZE      14
+
+enum LogsBinaryColumnType {
+  LOGS_COLUMN_TIME,      // uint32_t time in 10ms (radios without RTC)
+  LOGS_COLUMN_RTC,       // uint32_t seconds since 1970 + uint8_t 1/100s
+  LOGS_COLUMN_VALUE,     // signed integer of 1, 2 or 4 bytes
+  LOGS_COLUMN_HEX,       // unsigned integer of 1, 2, 4 or 8 bytes
+  LOGS_COLUMN_GPS,       // int32_t latitude + int32_t longitude (1/1000000 deg)
+  LOGS_COLUMN_DATETIME,  // uint16_t year, uint8_t month, day, hour, min, sec
+  LOGS_COLUMN_TEXT,      // char[size], not always '\0' terminated
+};
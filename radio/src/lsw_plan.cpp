@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "switches.h"
+#include "lsw_plan.h"
+
+static LswPlan _lsw_plan;
+static volatile bool _lsw_plan_valid = false;
+
+void lswPlanInvalidate()
+{
+  _lsw_plan_valid = false;
+}
+
+static inline uint64_t lsw_bit(uint8_t idx)
+{
+  return (uint64_t)1 << idx;
+}
+
+static uint64_t getSwitchDependency(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  if (swtch >= SWSRC_FIRST_LOGICAL_SWITCH && swtch <= SWSRC_LAST_LOGICAL_SWITCH)
+    return lsw_bit(swtch - SWSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+static uint64_t getSourceDependency(mixsrc_t src)
+{
+  if (src >= MIXSRC_FIRST_LOGICAL_SWITCH && src <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return lsw_bit(src - MIXSRC_FIRST_LOGICAL_SWITCH);
+  return 0;
+}
+
+// Bit 'n' of deps[i] is set when the evaluation of the logical switch
+// 'i' reads the state of the logical switch 'n'. The state of TIMER,
+// STICKY and EDGE is only read by the timer tick, and a logical switch
+// using itself always reads its previous state.
+static void getLogicalSwitchesDependencies(uint64_t* deps)
+{
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData* ls = lswAddress(i);
+    deps[i] = 0;
+    if (ls->func == LS_FUNC_NONE)
+      continue;
+
+    deps[i] |= getSwitchDependency(ls->andsw);
+    switch (lswFamily(ls->func)) {
+      case LS_FAMILY_BOOL:
+        deps[i] |= getSwitchDependency(ls->v1) | getSwitchDependency(ls->v2);
+        break;
+      case LS_FAMILY_COMP:
+        deps[i] |= getSourceDependency(ls->v1) | getSourceDependency(ls->v2);
+        break;
+      case LS_FAMILY_OFS:
+      case LS_FAMILY_DIFF:
+        deps[i] |= getSourceDependency(ls->v1);
+        break;
+    }
+    deps[i] &= ~lsw_bit(i);
+  }
+}
+
+static void compileLogicalSwitch(LswPlanEntry& entry, uint8_t idx)
+{
+  LogicalSwitchData* ls = lswAddress(idx);
+  uint8_t family = lswFamily(ls->func);
+
+  entry.idx = idx;
+  entry.flags = 0;
+  entry.v1 = { MIXSRC_CAT_NONE, 0 };
+  entry.v2 = { MIXSRC_CAT_NONE, 0 };
+
+  if (family == LS_FAMILY_TIMER || family == LS_FAMILY_STICKY ||
+      family == LS_FAMILY_EDGE)
+    entry.flags |= LSW_PLAN_TIMED;
+  if (ls->delay || ls->duration)
+    entry.flags |= LSW_PLAN_DELAYED;
+
+  if (family == LS_FAMILY_OFS || family == LS_FAMILY_DIFF ||
+      family == LS_FAMILY_COMP)
+    entry.v1 = resolveMixSource(ls->v1);
+  if (family == LS_FAMILY_COMP)
+    entry.v2 = resolveMixSource(ls->v2);
+}
+
+// Sort the logical switches so that each one comes after the
+// logical switches it uses, the members of a feedback loop being
+// evaluated together in index order (same as the mixer channels).
+static void buildLswPlan(LswPlan& plan)
+{
+  uint64_t deps[MAX_LOGICAL_SWITCHES];
+  uint64_t reach[MAX_LOGICAL_SWITCHES];
+  getLogicalSwitchesDependencies(deps);
+
+  // transitive closure (Warshall)
+  memcpy(reach, deps, sizeof(reach));
+  for (uint8_t k = 0; k < MAX_LOGICAL_SWITCHES; k++) {
+    for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+      if (reach[i] & lsw_bit(k)) reach[i] |= reach[k];
+    }
+  }
+
+  uint64_t done = 0;
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (lswAddress(i)->func == LS_FUNC_NONE) done |= lsw_bit(i);
+  }
+
+  // the feedback loops (strongly connected components), stored
+  // at the index of their first member, and what they depend on
+  uint64_t loops[MAX_LOGICAL_SWITCHES];
+  uint64_t loopDeps[MAX_LOGICAL_SWITCHES];
+  uint64_t leaders = 0;
+  uint64_t grouped = done;
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (grouped & lsw_bit(i)) continue;
+
+    uint64_t loop = lsw_bit(i);
+    uint64_t pending = deps[i];
+    for (uint8_t n = i + 1; n < MAX_LOGICAL_SWITCHES; n++) {
+      if ((reach[i] & lsw_bit(n)) && (reach[n] & lsw_bit(i))) {
+        loop |= lsw_bit(n);
+        pending |= deps[n];
+      }
+    }
+
+    loops[i] = loop;
+    loopDeps[i] = pending & ~loop;
+    leaders |= lsw_bit(i);
+    grouped |= loop;
+  }
+
+  // then the first loop with all its dependencies evaluated
+  plan.count = 0;
+  while (leaders) {
+    uint8_t next = 0;
+    while (next < MAX_LOGICAL_SWITCHES &&
+           (!(leaders & lsw_bit(next)) || (loopDeps[next] & ~done)))
+      next++;
+
+    // as the loops are merged, there is always one ready
+    if (next == MAX_LOGICAL_SWITCHES) break;
+
+    for (uint8_t i = next; i < MAX_LOGICAL_SWITCHES; i++) {
+      if (loops[next] & lsw_bit(i))
+        compileLogicalSwitch(plan.entries[plan.count++], i);
+    }
+    done |= loops[next];
+    leaders &= ~lsw_bit(next);
+  }
+}
+
+const LswPlan& lswPlanGet()
+{
+#if defined(SIMU)
+  if (modelCachesAlwaysRebuild) _lsw_plan_valid = false;
+#endif
+
+  if (!_lsw_plan_valid) {
+    // set first: an invalidation while building
+    // will trigger another build on next call
+    _lsw_plan_valid = true;
+    buildLswPlan(_lsw_plan);
+    logicalSwitchesResetUnused(_lsw_plan);
+  }
+
+  return _lsw_plan;
+}
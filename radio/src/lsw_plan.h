@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "dataconstants.h"
+#include "mixer_sources.h"
+
+// The logical switches plan is the list of the logical switches to
+// evaluate:
+//  - only the used logical switches,
+//  - sorted so that the logical switches used by other logical
+//    switches are evaluated first,
+//  - with their sources already resolved.
+//
+// Logical switches using each other (feedback loops) are evaluated
+// together in index order: the logical switch read before being
+// evaluated provides its state from the previous evaluation.
+//
+// It is rebuilt lazily after lswPlanInvalidate(), which is triggered
+// by storageDirty(EE_MODEL).
+
+enum LswPlanFlags {
+  // TIMER, STICKY or EDGE: the state is updated by the timer tick
+  LSW_PLAN_TIMED = (1 << 0),
+  // delay or duration: the timer is updated by the timer tick
+  LSW_PLAN_DELAYED = (1 << 1),
+};
+
+struct LswPlanEntry {
+  uint8_t idx;       // index in g_model.logicalSw
+  uint8_t flags;     // LswPlanFlags
+  MixSourceRef v1;   // resolved ls->v1 (sources only)
+  MixSourceRef v2;   // resolved ls->v2 (comparisons only)
+};
+
+struct LswPlan {
+  LswPlanEntry entries[MAX_LOGICAL_SWITCHES];
+  uint8_t count;
+};
+
+// Mark the plan as outdated: it will be rebuilt
+// before the next logical switches evaluation.
+void lswPlanInvalidate();
+
+// Return the current plan, rebuilding it first if needed.
+// Only to be used by the mixer task.
+const LswPlan& lswPlanGet();
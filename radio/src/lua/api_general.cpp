@@ -103,7 +103,7 @@ void luaFreeRxFifo()
 void luaReceiveData(uint8_t* buf, uint32_t len)
 {
   if (luaRxFifo) {
-    while(len--) luaRxFifo->push(*buf++);
+    luaRxFifo->push(buf, len);
   }
 }
 
@@ -448,12 +448,9 @@ static bool _searchSingleFields(const char* name, LuaField& field,
   return false;
 }
 
-/**
-  Return field data for a given field name
-*/
-bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
+static bool _findFieldByName(const char * name, size_t len, LuaField & field,
+                             unsigned int flags)
 {
-  auto len = strlen(name);
   strncpy(field.name, name, sizeof(field.name) - 1);
   field.name[sizeof(field.name) - 1] = '\0';
 
@@ -546,6 +543,85 @@ bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
   return false;  // not found
 }
 
+// Names resolved by luaFindFieldByName(), as the scripts use the same
+// names with getValue() on each run. Direct mapped on a hash of the name,
+// the names not found are kept as well.
+#if defined(COLORLCD)
+  #define LUA_FIELDS_CACHE_SIZE  64
+#else
+  #define LUA_FIELDS_CACHE_SIZE  16
+#endif
+
+#define LUA_FIELD_NOT_FOUND  0xFFFF
+
+struct LuaFieldsCacheEntry {
+  uint16_t id;
+  char name[sizeof(LuaField::name)];  // empty if the entry is free
+};
+
+static LuaFieldsCacheEntry _fields_cache[LUA_FIELDS_CACHE_SIZE];
+
+// the cache is valid when both serials are the same
+static volatile uint32_t _fields_serial = 1;
+static uint32_t _fields_cache_serial = 0;
+
+void luaFieldsCacheInvalidate()
+{
+  _fields_serial++;
+}
+
+static LuaFieldsCacheEntry * luaFieldsCacheEntry(const char * name, size_t len)
+{
+  if (len == 0 || len >= sizeof(LuaFieldsCacheEntry::name))
+    return nullptr;
+
+#if defined(SIMU)
+  if (modelCachesAlwaysRebuild) luaFieldsCacheInvalidate();
+#endif
+
+  uint32_t serial = _fields_serial;
+  if (serial != _fields_cache_serial) {
+    memclear(_fields_cache, sizeof(_fields_cache));
+    _fields_cache_serial = serial;
+  }
+
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; i++) {
+    hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+  }
+
+  return &_fields_cache[hash & (LUA_FIELDS_CACHE_SIZE - 1)];
+}
+
+/**
+  Return field data for a given field name
+*/
+bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags)
+{
+  auto len = strlen(name);
+
+  // descriptions are not cached, getFieldInfo() is not called that often
+  if (flags & FIND_FIELD_DESC)
+    return _findFieldByName(name, len, field, flags);
+
+  auto entry = luaFieldsCacheEntry(name, len);
+  if (entry && !strcmp(entry->name, name)) {
+    memcpy(field.name, name, len + 1);
+    field.desc[0] = '\0';
+    field.id = entry->id;
+    return entry->id != LUA_FIELD_NOT_FOUND;
+  }
+
+  bool found = _findFieldByName(name, len, field, flags);
+  if (entry) {
+    entry->id = found ? field.id : LUA_FIELD_NOT_FOUND;
+    memcpy(entry->name, name, len + 1);
+  }
+
+  return found;
+}
+
 // Return field data for a given field id
 bool luaFindFieldById(int id, LuaField & field, unsigned int flags)
 {
@@ -627,7 +703,7 @@ The list of valid sources is available:
 | 2.2 | [X9D and X9D+](http://downloads.open-tx.org/2.2/release/firmware/lua_fields_x9d.txt), [X9E](http://downloads.open-tx.org/2.2/release/firmware/lua_fields_x9e.txt), [Horus](http://downloads.open-tx.org/2.2/release/firmware/lua_fields_x12s.txt) |
 | 2.3 | [X9D and X9D+](http://downloads.open-tx.org/2.3/release/firmware/lua_fields_x9d.txt), [X9E](http://downloads.open-tx.org/2.3/release/firmware/lua_fields_x9e.txt), [X7](http://downloads.open-tx.org/2.3/release/firmware/lua_fields_x7.txt), [Horus](http://downloads.open-tx.org/2.3/release/firmware/lua_fields_x12s.txt) |
 
-@param source can be an index (number) (which was obtained by `getFieldInfo` or `getSourceIndex`) or a name (string) of the source.
+@param source can be an index (number) (which was obtained by `getFieldId`, `getFieldInfo` or `getSourceIndex`) or a name (string) of the source.
 
 @retval table information about requested field, table elements:
  * `id`   (number) field identifier
@@ -683,7 +759,7 @@ To get a telemetry value simply use it's sensor name. For example:
  * to get the current altitude use the source "Alt"
  * to get the minimum altitude use the source "Alt-", to get the maximum use "Alt+"
 
-@param source can be an index (number) (which was obtained by `getFieldInfo` or `getSourceIndex`) or a name (string) of the source.
+@param source can be an index (number) (which was obtained by `getFieldId`, `getFieldInfo` or `getSourceIndex`) or a name (string) of the source.
 
 @retval value current source value (number). Zero is returned for:
  * non-existing sources
@@ -731,6 +807,114 @@ static int luaGetValue(lua_State * L)
   return 1;
 }
 
+/*luadoc
+@function getFieldId(name)
+
+Returns the identifier of a field (source) from its name, as accepted by `getValue`.
+
+@param name (string) name of the field, i.e. "RSSI", "ch1" or "Alt+"
+
+@retval number field identifier, to be used with `getValue`
+
+@retval nil the requested field was not found
+
+@notice The identifier of a telemetry sensor changes when the sensors are
+deleted or reordered. Resolve the names once in the script `init` function
+and pass the identifiers to `getValue` afterwards.
+
+@status current Introduced in 2.10
+*/
+static int luaGetFieldId(lua_State * L)
+{
+  LuaField field;
+  if (luaFindFieldByName(luaL_checkstring(L, 1), field)) {
+    lua_pushinteger(L, field.id);
+  }
+  else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+/*luadoc
+@function getValues(sources, values [, current [, fresh]])
+
+Reads the values of many sources at once, into tables created beforehand.
+Numbers, booleans and the existing tables are reused: unlike calling `getValue`
+for each source, nothing is left for the garbage collector on each call
+(except for the sources returning tables or strings: GPS, date/time, cells and
+text sensors).
+
+@param sources (table) array of source identifiers (from `getFieldId` or
+`getSourceIndex`) or names. Use the "-" and "+" names/identifiers for the
+telemetry min and max values.
+
+@param values (table) filled with the values of the sources, at the same
+indexes, as returned by `getValue`
+
+@param current (table) optional, filled with `true` for telemetry sources
+within the "Sensor Lost" duration while telemetry is streaming, always `true`
+for non-telemetry sources
+
+@param fresh (table) optional, filled with `true` for telemetry sources
+recently updated while telemetry is streaming, always `true` for non-telemetry
+sources
+
+@retval number the number of sources read
+
+@notice Resolve the names with `getFieldId` in the script `init` function, the
+identifiers are read without any lookup.
+
+@status current Introduced in 2.10
+*/
+static int luaGetValues(lua_State * L)
+{
+  luaL_checktype(L, 1, LUA_TTABLE);
+  luaL_checktype(L, 2, LUA_TTABLE);
+  bool withCurrent = lua_istable(L, 3);
+  bool withFresh = lua_istable(L, 4);
+
+  int count = lua_rawlen(L, 1);
+  for (int i = 1; i <= count; i++) {
+    int src = MIXSRC_NONE;
+    lua_rawgeti(L, 1, i);
+    if (lua_type(L, -1) == LUA_TNUMBER) {
+      src = lua_tointeger(L, -1);
+    }
+    else if (lua_type(L, -1) == LUA_TSTRING) {
+      LuaField field;
+      if (luaFindFieldByName(lua_tostring(L, -1), field)) {
+        src = field.id;
+      }
+    }
+    lua_pop(L, 1);
+
+    luaGetValueAndPush(L, src);
+    lua_rawseti(L, 2, i);
+
+    if (withCurrent || withFresh) {
+      bool current = true, fresh = true;
+      if (src >= MIXSRC_FIRST_TELEM && src <= MIXSRC_LAST_TELEM) {
+        TelemetryItem & item = telemetryItems[(src - MIXSRC_FIRST_TELEM) / 3];
+        bool available = TELEMETRY_STREAMING() && item.isAvailable();
+        current = available && !item.isOld();
+        fresh = available && item.isFresh();
+      }
+      if (withCurrent) {
+        lua_pushboolean(L, current);
+        lua_rawseti(L, 3, i);
+      }
+      if (withFresh) {
+        lua_pushboolean(L, fresh);
+        lua_rawseti(L, 4, i);
+      }
+    }
+  }
+
+  lua_pushinteger(L, count);
+  return 1;
+}
+
 /*luadoc
 @function getSourceValue(source)
 
@@ -751,7 +935,7 @@ To get a telemetry value simply use it's sensor name. For example:
  * to get the current altitude use the source "Alt"
  * to get the minimum altitude use the source "Alt-", to get the maximum use "Alt+"
 
-@param source can be an index (number) (which was obtained by `getFieldInfo` or `getSourceIndex`) or a name (string) of the source.
+@param source can be an index (number) (which was obtained by `getFieldId`, `getFieldInfo` or `getSourceIndex`) or a name (string) of the source.
 
 @retval value current source value (number), or last known telemetry item value.
 
@@ -927,9 +1111,7 @@ static int luaSportTelemetryPop(lua_State * L)
 
   if (luaInputTelemetryFifo->size() >= sizeof(SportTelemetryPacket)) {
     SportTelemetryPacket packet;
-    for (uint8_t i=0; i<sizeof(packet); i++) {
-      luaInputTelemetryFifo->pop(packet.raw[i]);
-    }
+    luaInputTelemetryFifo->pop(packet.raw, sizeof(packet));
     lua_pushnumber(L, packet.physicalId);
     lua_pushnumber(L, packet.primId);
     lua_pushnumber(L, packet.dataId);
@@ -1976,6 +2158,7 @@ static int luaSetTelemetryValue(lua_State * L)
       telemetrySensor.subId = subId;
       telemetrySensor.instance = instance;
       telemetrySensor.init(name ? name: name_buf, unit, prec);
+      telemetrySensorsIndexInvalidate();
       lua_pushboolean(L, true);
     } else {
       lua_pushboolean(L, false);
@@ -2913,6 +3096,8 @@ LROT_BEGIN(etxlib, NULL, 0)
   LROT_FUNCENTRY( getRotEncSpeed, luaGetRotEncSpeed )
   LROT_FUNCENTRY( getRotEncMode, luaGetRotEncMode )
   LROT_FUNCENTRY( getValue, luaGetValue )
+  LROT_FUNCENTRY( getFieldId, luaGetFieldId )
+  LROT_FUNCENTRY( getValues, luaGetValues )
   LROT_FUNCENTRY( getOutputValue, luaGetOutputValue )
   LROT_FUNCENTRY( getSourceValue, luaGetSourceValue )
   LROT_FUNCENTRY( getTrainerStatus, luaGetTrainerStatus )
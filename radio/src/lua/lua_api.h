@@ -230,6 +230,8 @@ struct LuaField {
 
 bool luaFindFieldByName(const char * name, LuaField & field, unsigned int flags=0);
 bool luaFindFieldById(int id, LuaField & field, unsigned int flags=0);
+// to be called when the fields names may have changed (model, sensors)
+void luaFieldsCacheInvalidate();
 void luaLoadThemes();
 void luaRegisterLibraries(lua_State * L);
 void registerBitmapClass(lua_State * L);
@@ -265,6 +267,7 @@ void * tracer_alloc(void * ud, void * ptr, size_t osize, size_t nsize);
 #define luaInit()
 #define LUA_INIT_THEMES_AND_WIDGETS()
 #define LUA_LOAD_MODEL_SCRIPTS()
+#define luaFieldsCacheInvalidate()
 
 #endif // defined(LUA)
 
@@ -24,6 +24,7 @@
 #include "hal/adc_driver.h"
 #include "hal/storage.h"
 #include "hal/abnormal_reboot.h"
+#include "file_sink.h"
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -534,6 +535,7 @@ void perMain()
   DEBUG_TIMER_START(debugTimerPerMain1);
 
   checkSpeakerVolume();
+  checkModelCaches();
 
   if (!usbPlugged() || (getSelectedUsbMode() == USB_UNSELECTED_MODE)) {
     checkEeprom();
@@ -542,6 +544,7 @@ void perMain()
       initLoggingTimer();  // initialize software timer for logging
     #else
       logsWrite();         // call logsWrite the old way for simu
+      fileSinksWakeup();   // and write the logs from here too
     #endif
   }
 
@@ -25,6 +25,7 @@
 #include "switches.h"
 #include "input_mapping.h"
 #include "mixes.h"
+#include "mixer_plan.h"
 
 #include "hal/adc_driver.h"
 #include "hal/trainer_driver.h"
@@ -313,156 +314,130 @@ static const getvalue_t _switch_3pos_lookup[] = {
 // *valid added to return status to Lua for invalid sources
 getvalue_t getValue(mixsrc_t i, bool* valid)
 {
-  if (i == MIXSRC_NONE) {
-    if (valid != nullptr) *valid = false;
-    return 0;
-  }
-  else if (i <= MIXSRC_LAST_INPUT) {
-    return anas[i - MIXSRC_FIRST_INPUT];
-  }
-#if defined(LUA_INPUTS)
-  else if (i <= MIXSRC_LAST_LUA) {
-#if defined(LUA_MODEL_SCRIPTS)
-    div_t qr = div(i-MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
-    return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
-#else
-    if (valid != nullptr) *valid = false;
-    return 0;
-#endif
-  }
-#endif
+  return getValue(resolveMixSource(i), valid);
+}
 
-  else if (i <= MIXSRC_LAST_STICK) {
-    i -= MIXSRC_FIRST_STICK;
-    if (i >= adcGetMaxInputs(ADC_INPUT_MAIN)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    return calibratedAnalogs[inputMappingConvertMode(i)];
-  }
-  else if (i <= MIXSRC_LAST_POT) {
-    i -= MIXSRC_FIRST_POT;
-    if (i >= adcGetMaxInputs(ADC_INPUT_FLEX)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
+getvalue_t getValue(MixSourceRef src, bool* valid)
+{
+  uint8_t i = src.index;
+
+  switch (src.category) {
+    case MIXSRC_CAT_INPUT:
+      return anas[i];
+
+#if defined(LUA_INPUTS) && defined(LUA_MODEL_SCRIPTS)
+    case MIXSRC_CAT_LUA: {
+      div_t qr = div(i, MAX_SCRIPT_OUTPUTS);
+      return scriptInputsOutputs[qr.quot].outputs[qr.rem].value;
     }
-    return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_FLEX)];
-  }
+#endif
+
+    case MIXSRC_CAT_STICK:
+      if (i >= adcGetMaxInputs(ADC_INPUT_MAIN))
+        break;
+      return calibratedAnalogs[inputMappingConvertMode(i)];
+
+    case MIXSRC_CAT_POT:
+      if (i >= adcGetMaxInputs(ADC_INPUT_FLEX))
+        break;
+      return calibratedAnalogs[i + adcGetInputOffset(ADC_INPUT_FLEX)];
 
 #if defined(IMU)
-  else if (i == MIXSRC_TILT_X) {
-    return gyro.scaledX();
-  }
-  else if (i == MIXSRC_TILT_Y) {
-    return gyro.scaledY();
-  }
+    case MIXSRC_CAT_TILT:
+      return i == 0 ? gyro.scaledX() : gyro.scaledY();
 #endif
 
 #if defined(SPACEMOUSE)
-  else if (i >= MIXSRC_FIRST_SPACEMOUSE && i <= MIXSRC_LAST_SPACEMOUSE) {
-    return get_spacemouse_value(i - MIXSRC_FIRST_SPACEMOUSE);
-  }
+    case MIXSRC_CAT_SPACEMOUSE:
+      return get_spacemouse_value(i);
 #endif
 
-  else if (i == MIXSRC_MIN) {
-    return -RESX;
-  }
-  else if (i == MIXSRC_MAX) {
-    return RESX;
-  }
+    case MIXSRC_CAT_MIN:
+      return -RESX;
+
+    case MIXSRC_CAT_MAX:
+      return RESX;
 
-  else if (i <= MIXSRC_LAST_HELI) {
 #if defined(HELI)
-    return cyc_anas[i - MIXSRC_FIRST_HELI];
-#else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    case MIXSRC_CAT_HELI:
+      return cyc_anas[i];
 #endif
-  }
 
-  else if (i <= MIXSRC_LAST_TRIM) {
-    i -= MIXSRC_FIRST_TRIM;
-    auto trim_value = getTrimValue(mixerCurrentFlightMode, i);
-    return calc1000toRESX((int16_t)8 * trim_value);
-  }
-  else if (i >= MIXSRC_FIRST_SWITCH && i <= MIXSRC_LAST_SWITCH) {
-    auto sw_idx = (uint8_t)(i - MIXSRC_FIRST_SWITCH);
+    case MIXSRC_CAT_TRIM: {
+      auto trim_value = getTrimValue(mixerCurrentFlightMode, i);
+      return calc1000toRESX((int16_t)8 * trim_value);
+    }
+
+    case MIXSRC_CAT_SWITCH: {
 #if defined(FUNCTION_SWITCHES)
-    auto max_reg_switches = switchGetMaxSwitches();
-    if (sw_idx >= max_reg_switches) {
-      auto fct_idx = sw_idx - max_reg_switches;
-      auto max_fct_switches = switchGetMaxFctSwitches();
-      if (fct_idx < max_fct_switches) {
-	return _switch_2pos_lookup[getFSLogicalState(fct_idx)];
+      auto max_reg_switches = switchGetMaxSwitches();
+      if (i >= max_reg_switches) {
+        auto fct_idx = i - max_reg_switches;
+        auto max_fct_switches = switchGetMaxFctSwitches();
+        if (fct_idx < max_fct_switches) {
+          return _switch_2pos_lookup[getFSLogicalState(fct_idx)];
+        }
       }
-    }
 #endif
-    auto sw_cfg = (SwitchConfig)SWITCH_CONFIG(sw_idx);
-    switch(sw_cfg) {
-    case SWITCH_NONE:
-      if (valid != nullptr) *valid = false;
-      return 0;
-    case SWITCH_TOGGLE:
-    case SWITCH_2POS:
-      return _switch_2pos_lookup[switchGetPosition(sw_idx)];
-    case SWITCH_3POS:
-      return _switch_3pos_lookup[switchGetPosition(sw_idx)];
+      auto sw_cfg = (SwitchConfig)SWITCH_CONFIG(i);
+      switch(sw_cfg) {
+      case SWITCH_NONE:
+        break;
+      case SWITCH_TOGGLE:
+      case SWITCH_2POS:
+        return _switch_2pos_lookup[switchGetPosition(i)];
+      case SWITCH_3POS:
+        return _switch_3pos_lookup[switchGetPosition(i)];
+      }
+      break;
     }
-  }
 
-  else if (i <= MIXSRC_LAST_LOGICAL_SWITCH) {
-    return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i - MIXSRC_FIRST_LOGICAL_SWITCH) ? 1024 : -1024;
-  } else if (i <= MIXSRC_LAST_TRAINER) {
-    int16_t x = trainerInput[i - MIXSRC_FIRST_TRAINER];
-    if (i < MIXSRC_FIRST_TRAINER + NUM_CAL_PPM) {
-      x -= g_eeGeneral.trainer.calib[i - MIXSRC_FIRST_TRAINER];
+    case MIXSRC_CAT_LOGICAL_SWITCH:
+      return getSwitch(SWSRC_FIRST_LOGICAL_SWITCH + i) ? 1024 : -1024;
+
+    case MIXSRC_CAT_TRAINER: {
+      int16_t x = trainerInput[i];
+      if (i < NUM_CAL_PPM) {
+        x -= g_eeGeneral.trainer.calib[i];
+      }
+      return x * 2;
     }
-    return x * 2;
-  } else if (i <= MIXSRC_LAST_CH) {
-    return ex_chans[i - MIXSRC_FIRST_CH];
-  }
 
-  else if (i <= MIXSRC_LAST_GVAR) {
+    case MIXSRC_CAT_CH:
+      return ex_chans[i];
+
 #if defined(GVARS)
-    return GVAR_VALUE(i - MIXSRC_FIRST_GVAR, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_FIRST_GVAR));
-#else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    case MIXSRC_CAT_GVAR:
+      return getGVarValue(i, mixerCurrentFlightMode);
 #endif
-  }
 
-  else if (i == MIXSRC_TX_VOLTAGE) {
-    return g_vbat100mV;
-  } else if (i < MIXSRC_FIRST_TIMER) {
-    // TX_TIME + SPARES
+    case MIXSRC_CAT_TX_VOLTAGE:
+      return g_vbat100mV;
+
 #if defined(RTCLOCK)
-    return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
-#else
-    if (valid != nullptr) *valid = false;
-    return 0;
+    case MIXSRC_CAT_TX_TIME:
+      return (g_rtcTime % SECS_PER_DAY) / 60; // number of minutes from midnight
 #endif
-  } else if (i <= MIXSRC_LAST_TIMER) {
-    return timersStates[i - MIXSRC_FIRST_TIMER].val;
-  }
 
-  else if (i <= MIXSRC_LAST_TELEM) {
-    if (IS_FAI_FORBIDDEN(i)) {
-      if (valid != nullptr) *valid = false;
-      return 0;
-    }
-    i -= MIXSRC_FIRST_TELEM;
-    div_t qr = div(i, 3);
-    TelemetryItem & telemetryItem = telemetryItems[qr.quot];
-    switch (qr.rem) {
-      case 1:
-        return telemetryItem.valueMin;
-      case 2:
-        return telemetryItem.valueMax;
-      default:
-        return telemetryItem.value;
+    case MIXSRC_CAT_TIMER:
+      return timersStates[i].val;
+
+    case MIXSRC_CAT_TELEM: {
+      if (IS_FAI_FORBIDDEN(MIXSRC_FIRST_TELEM + i))
+        break;
+      div_t qr = div(i, 3);
+      TelemetryItem & telemetryItem = telemetryItems[qr.quot];
+      switch (qr.rem) {
+        case 1:
+          return telemetryItem.valueMin;
+        case 2:
+          return telemetryItem.valueMax;
+        default:
+          return telemetryItem.value;
+      }
     }
   }
-  
+
   if (valid != nullptr) *valid = false;
   return 0;
 }
@@ -621,29 +596,132 @@ int getSourceTrimValue(int source, int stickValue=0)
   }
 }
 
-constexpr bitfield_channels_t all_channels_dirty = (bitfield_channels_t)-1;
-
 static inline bitfield_channels_t channel_bit(uint16_t ch)
 {
   return (bitfield_channels_t)1 << ch;
 }
 
-static inline bitfield_channels_t channel_dirty(bitfield_channels_t mask, uint16_t ch)
+static inline int32_t mixLineWeight(const MixerPlanLine& line, const MixData* md)
 {
-  return mask & channel_bit(ch);
+  if (line.flags & MIXER_PLAN_GVAR_WEIGHT) {
+    int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG,
+                                    GV_RANGELARGE, mixerCurrentFlightMode);
+    return calc100to256_16Bits(weight);
+  }
+  return line.weight;
 }
 
-static inline bitfield_channels_t upper_channels_mask(uint16_t ch)
+static inline int32_t mixLineOffset(const MixerPlanLine& line, const MixData* md)
 {
-  // take the 2's complement to generate a bit pattern
-  // that has all bits of 'ch' order and above set
-  //
-  // Examples (mask for max 8 channels):
-  // - channel 0: 0b11111111
-  // - channel 1: 0b11111110
-  // - channel 2: 0b11111100
-
-  return ~(channel_bit(ch)) + 1;
+  if (line.flags & MIXER_PLAN_GVAR_OFFSET) {
+    int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG,
+                                    GV_RANGELARGE, mixerCurrentFlightMode);
+    if (offset) return divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+    return 0;
+  }
+  return line.offset;
+}
+
+// During a flight mode fade, the active flight mode is evaluated first
+// and records the values of the mixer lines which do not depend on the
+// flight mode. The other fading flight modes reuse these values as long
+// as the inputs, trims and channels they use have the same values.
+enum MixerFadeShareMode {
+  MIXER_FADE_OFF,
+  MIXER_FADE_RECORD,
+  MIXER_FADE_REUSE,
+};
+
+enum MixLineShareState {
+  MIX_LINE_NOT_SHARED,
+  MIX_LINE_SHARED_OFF,    // line not active
+  MIX_LINE_SHARED_VALUE,
+};
+
+static uint8_t _fade_share_mode = MIXER_FADE_OFF;
+
+static struct {
+  uint8_t state[MAX_MIXERS];   // indexed as MixerPlan::lines
+  int32_t value[MAX_MIXERS];
+  int16_t anas[MAX_INPUTS];
+  int8_t inputsTrims[MAX_INPUTS];
+  int16_t trims[MAX_TRIMS];
+} _fade_share;
+
+static_assert(MAX_INPUTS <= 32, "inputs must fit in a 32 bits mask");
+
+static inline bool isMixLineShared(const MixerPlanLine& line,
+                                   uint32_t sharedInputs, bool sharedTrims,
+                                   bitfield_channels_t sharedChannels)
+{
+  if (!(line.flags & MIXER_PLAN_FM_SHARED))
+    return false;
+  if ((line.flags & MIXER_PLAN_HAS_TRIM) && !sharedTrims)
+    return false;
+  if (line.source == MIXER_PLAN_SRC_INPUT)
+    return sharedInputs & ((uint32_t)1 << line.srcIndex);
+  if (line.source == MIXER_PLAN_SRC_CHANNEL)
+    return sharedChannels & channel_bit(line.srcIndex);
+  return true;
+}
+
+static inline void mixChannelValue(int32_t * ptr, int32_t dv, uint8_t mltpx)
+{
+  switch (mltpx) {
+    case MLTPX_REPL:
+      *ptr = dv;
+      break;
+    case MLTPX_MUL:
+      // @@@2 we have to remove the weight factor of 256 in case of 100%; now we use the new base of 256
+      dv >>= 8;
+      dv *= *ptr;
+      dv >>= RESX_SHIFT;   // same as dv /= RESXl;
+      *ptr = dv;
+      break;
+    default: // MLTPX_ADD
+      *ptr += dv; //Mixer output add up to the line (dv + (dv>0 ? 100/2 : -100/2))/(100);
+      break;
+  } // endswitch mltpx
+#ifdef PREVENT_ARITHMETIC_OVERFLOW
+/*
+  // a lot of assumptions must be true, for this kind of check; not really worth for only 4 bytes flash savings
+  // this solution would save again 4 bytes flash
+  int8_t testVar=(*ptr<<1)>>24;
+  if ( (testVar!=-1) && (testVar!=0 ) ) {
+    // this devices by 64 which should give a good balance between still over 100% but lower then 32x100%; should be OK
+    *ptr >>= 6;  // this is quite tricky, reduces the value a lot but should be still over 100% and reduces flash need
+  } */
+
+
+  PACK( union u_int16int32_t {
+    struct {
+      int16_t lo;
+      int16_t hi;
+    } words_t;
+    int32_t dword;
+  });
+
+  u_int16int32_t tmp;
+  tmp.dword=*ptr;
+
+  if (tmp.dword<0) {
+    if ((tmp.words_t.hi&0xFF80)!=0xFF80) tmp.words_t.hi=0xFF86; // set to min nearly
+  }
+  else {
+    if ((tmp.words_t.hi|0x007F)!=0x007F) tmp.words_t.hi=0x0079; // set to max nearly
+  }
+  *ptr = tmp.dword;
+  // this implementation saves 18bytes flash
+
+/*dv=*ptr>>8;
+  if (dv>(32767-RESXl)) {
+    *ptr=(32767-RESXl)<<8;
+  } else if (dv<(-32767+RESXl)) {
+    *ptr=(-32767+RESXl)<<8;
+  }*/
+  // *ptr=limit( int32_t(int32_t(-1)<<23), *ptr, int32_t(int32_t(1)<<23));  // limit code cost 72 bytes
+  // *ptr=limit( int32_t((-32767+RESXl)<<8), *ptr, int32_t((32767-RESXl)<<8));  // limit code cost 80 bytes
+#endif
 }
 
 uint8_t mixerCurrentFlightMode;
@@ -727,49 +805,75 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
   //========== MIXER LOOP ===============
 
-  uint8_t pass = 0;
+  const MixerPlan& plan = mixerPlanGet();
   uint8_t lv_mixWarning = 0;
-  bitfield_channels_t dirtyChannels = all_channels_dirty;
 
-  do {
-    bitfield_channels_t passDirtyChannels = 0;
+  // inputs and trims with the same values as in the active flight mode
+  uint32_t sharedInputs = 0;
+  bool sharedTrims = false;
+  if (_fade_share_mode == MIXER_FADE_RECORD) {
+    memcpy(_fade_share.anas, anas, sizeof(_fade_share.anas));
+    memcpy(_fade_share.inputsTrims, virtualInputsTrims, sizeof(_fade_share.inputsTrims));
+    memcpy(_fade_share.trims, trims, sizeof(_fade_share.trims));
+  } else if (_fade_share_mode == MIXER_FADE_REUSE) {
+    for (uint8_t i = 0; i < MAX_INPUTS; i++) {
+      if (anas[i] == _fade_share.anas[i] &&
+          virtualInputsTrims[i] == _fade_share.inputsTrims[i])
+        sharedInputs |= (uint32_t)1 << i;
+    }
+    sharedTrims = !memcmp(trims, _fade_share.trims, sizeof(trims));
+  }
+
+  // channels with the same values as in the active flight mode
+  // (channels not computed yet provide their previous cycle value)
+  bitfield_channels_t sharedChannels = (bitfield_channels_t)-1;
 
-    for (uint8_t i=0; i<MAX_MIXERS; i++) {
-      if (mode == e_perout_mode_normal && pass == 0)
-        swOn[i].activeMix = 0;
+  // channels not computed yet in this cycle
+  bitfield_channels_t pendingChannels = plan.usedChannels;
 
+  for (uint8_t c = 0; c < plan.channelsCount; c++) {
+    const MixerPlanChannel& chan = plan.channels[c];
+    const MixerPlanLine* firstLine = &plan.lines[chan.firstLine];
+    const MixerPlanLine* lastLine = firstLine + chan.linesCount;
+
+    for (const MixerPlanLine* line = firstLine; line < lastLine; line++) {
+      uint8_t i = line->index;
+      uint8_t k = line - plan.lines;
       MixData * md = mixAddress(i);
 
-      if (md->srcRaw == 0) {
-#if defined(COLORLCD)
-        continue;
-#else
-        break;
-#endif
-      }
+      if (mode == e_perout_mode_normal)
+        swOn[i].activeMix = 0;
 
-      if (!channel_dirty(dirtyChannels, md->destCh))
-        continue;
+      if (_fade_share_mode == MIXER_FADE_REUSE) {
+        if (_fade_share.state[k] != MIX_LINE_NOT_SHARED &&
+            isMixLineShared(*line, sharedInputs, sharedTrims, sharedChannels)) {
+          if (_fade_share.state[k] == MIX_LINE_SHARED_VALUE)
+            mixChannelValue(&chans[md->destCh], _fade_share.value[k], md->mltpx);
+          continue;
+        }
+        sharedChannels &= ~channel_bit(chan.destCh);
+      } else if (_fade_share_mode == MIXER_FADE_RECORD) {
+        // until a value is computed below
+        _fade_share.state[k] = MIX_LINE_SHARED_OFF;
+      }
 
-      // if this is the first calculation for the destination channel,
-      // initialize it with 0 (otherwise would be random)
-      if (i == 0 || md->destCh != (md - 1)->destCh)
-        chans[md->destCh] = 0;
+      // a delayed value is only used in the active flight mode
+      bool shareable = true;
 
       //========== FLIGHT MODE && SWITCH =====
-      bool fmEnabled = (md->flightModes & (1 << mixerCurrentFlightMode)) == 0;
-      bool mixLineActive = fmEnabled && getSwitch(md->swtch);
+      bool mixLineActive = (md->flightModes & (1 << mixerCurrentFlightMode)) == 0;
+      if (mixLineActive && (line->flags & MIXER_PLAN_HAS_SWITCH))
+        mixLineActive = getSwitch(md->swtch);
 
       if (mixLineActive) {
         // disable mixer using trainer channels if not connected
-        if (md->srcRaw >= MIXSRC_FIRST_TRAINER &&
-            md->srcRaw <= MIXSRC_LAST_TRAINER && !is_trainer_connected()) {
+        if (line->source == MIXER_PLAN_SRC_TRAINER && !is_trainer_connected()) {
           mixLineActive = false;
         }
 
 #if defined(LUA_MODEL_SCRIPTS)
         // disable mixer if Lua script is used as source and script was killed
-        if (md->srcRaw >= MIXSRC_FIRST_LUA && md->srcRaw <= MIXSRC_LAST_LUA) {
+        if (line->source == MIXER_PLAN_SRC_LUA) {
           div_t qr = div(md->srcRaw - MIXSRC_FIRST_LUA, MAX_SCRIPT_OUTPUTS);
           if (scriptInternalData[qr.quot].state != SCRIPT_OK) {
             mixLineActive = false;
@@ -783,34 +887,16 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
       if (mode > e_perout_mode_inactive_flight_mode) {
         if (!mixLineActive) continue;
-        v = getValue(md->srcRaw);
+        v = getValue(line->src);
+      } else if (line->source == MIXER_PLAN_SRC_CHANNEL &&
+                 !(pendingChannels & channel_bit(line->srcIndex))) {
+        // the source channel has already been computed in this cycle
+        // channels are in [ -1024 * 256, 1024 * 256 ]
+        v = chans[line->srcIndex] >> 8;
       } else {
-        mixsrc_t srcRaw = md->srcRaw;
-        v = getValue(srcRaw);
-
-        if (srcRaw >= MIXSRC_FIRST_CH) {
-
-          auto srcChan = srcRaw - MIXSRC_FIRST_CH;
-          if (srcChan <= MAX_OUTPUT_CHANNELS && md->destCh != srcChan) {
-
-            // check whether we need to recompute the current channel later
-            bitfield_channels_t upperChansMask = upper_channels_mask(md->destCh);
-            bitfield_channels_t srcChanDirtyMask = channel_dirty(dirtyChannels, srcChan);
-
-            // if the source is any of the channels marked as dirty
-            // or contained in [ destCh, MAX_OUTPUT_CHANNELS [
-            if (srcChanDirtyMask & (passDirtyChannels | upperChansMask)) {
-              passDirtyChannels |= channel_bit(md->destCh);
-            }
-
-            // if the source has already be computed,
-            // then use it!
-            if (srcChan < md->destCh || pass > 0) {
-              // channels are in [ -1024 * 256, 1024 * 256 ]
-              v = chans[srcChan] >> 8;
-            }
-          }
-        }
+        // for a channel not computed yet (itself or a feedback loop),
+        // this is the value from the previous cycle
+        v = getValue(line->src);
       }
 
       bool applyOffsetAndCurve = true;
@@ -830,13 +916,14 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
       if (mode == e_perout_mode_normal && swOn[i].delay > 0) {
         swOn[i].delay = max<int16_t>(0, (int16_t)swOn[i].delay - tick10ms);
         v = _swPrev;
+        shareable = false;
       }
       else {
         if (mode == e_perout_mode_normal) {
           swOn[i].now = swOn[i].prev = v_active;
         }
         if (!mixLineActive) {
-          if ((md->speedDown || md->speedUp) && md->mltpx != MLTPX_REPL) {
+          if ((line->flags & MIXER_PLAN_HAS_SPEED) && md->mltpx != MLTPX_REPL) {
             v = (md->mltpx == MLTPX_ADD ? 0 : RESX);
             applyOffsetAndCurve = false;
           } else  {
@@ -863,13 +950,12 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         }
       }
 
-      int32_t weight = GET_GVAR_PREC1(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-      weight = calc100to256_16Bits(weight);
+      int32_t weight = mixLineWeight(*line, md);
       //========== SPEED ===============
       // now its on input side, but without weight compensation. More like other remote controls
       // lower weight causes slower movement
 
-      if (mode <= e_perout_mode_inactive_flight_mode && (md->speedUp || md->speedDown)) { // there are delay values
+      if (mode <= e_perout_mode_inactive_flight_mode && (line->flags & MIXER_PLAN_HAS_SPEED)) { // there are delay values
 #define DEL_MULT_SHIFT 8
         // we recale to a mult 256 higher value for calculation
         int32_t tact = act[i];
@@ -917,8 +1003,7 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 
       //========== OFFSET / AFTER ===============
       if (applyOffsetAndCurve) {
-        int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE, mixerCurrentFlightMode);
-        if (offset) dv += divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+        dv += mixLineOffset(*line, md);
       }
 
       //========== DIFFERENTIAL =========
@@ -926,74 +1011,21 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
         dv = applyCurve(dv, md->curve);
       }
 
-      int32_t * ptr = &chans[md->destCh]; // Save calculating address several times
-
-      switch (md->mltpx) {
-        case MLTPX_REPL:
-          *ptr = dv;
-          if (mode == e_perout_mode_normal) {
-            for (uint8_t m=i-1; m<MAX_MIXERS && mixAddress(m)->destCh==md->destCh; m--)
-              swOn[m].activeMix = false;
-          }
-          break;
-        case MLTPX_MUL:
-          // @@@2 we have to remove the weight factor of 256 in case of 100%; now we use the new base of 256
-          dv >>= 8;
-          dv *= *ptr;
-          dv >>= RESX_SHIFT;   // same as dv /= RESXl;
-          *ptr = dv;
-          break;
-        default: // MLTPX_ADD
-          *ptr += dv; //Mixer output add up to the line (dv + (dv>0 ? 100/2 : -100/2))/(100);
-          break;
-      } // endswitch md->mltpx
-#ifdef PREVENT_ARITHMETIC_OVERFLOW
-/*
-      // a lot of assumptions must be true, for this kind of check; not really worth for only 4 bytes flash savings
-      // this solution would save again 4 bytes flash
-      int8_t testVar=(*ptr<<1)>>24;
-      if ( (testVar!=-1) && (testVar!=0 ) ) {
-        // this devices by 64 which should give a good balance between still over 100% but lower then 32x100%; should be OK
-        *ptr >>= 6;  // this is quite tricky, reduces the value a lot but should be still over 100% and reduces flash need
-      } */
-
-
-      PACK( union u_int16int32_t {
-        struct {
-          int16_t lo;
-          int16_t hi;
-        } words_t;
-        int32_t dword;
-      });
-
-      u_int16int32_t tmp;
-      tmp.dword=*ptr;
-
-      if (tmp.dword<0) {
-        if ((tmp.words_t.hi&0xFF80)!=0xFF80) tmp.words_t.hi=0xFF86; // set to min nearly
-      }
-      else {
-        if ((tmp.words_t.hi|0x007F)!=0x007F) tmp.words_t.hi=0x0079; // set to max nearly
+      if (_fade_share_mode == MIXER_FADE_RECORD) {
+        _fade_share.state[k] = shareable ? MIX_LINE_SHARED_VALUE : MIX_LINE_NOT_SHARED;
+        _fade_share.value[k] = dv;
       }
-      *ptr = tmp.dword;
-      // this implementation saves 18bytes flash
-
-/*      dv=*ptr>>8;
-      if (dv>(32767-RESXl)) {
-        *ptr=(32767-RESXl)<<8;
-      } else if (dv<(-32767+RESXl)) {
-        *ptr=(-32767+RESXl)<<8;
-      }*/
-      // *ptr=limit( int32_t(int32_t(-1)<<23), *ptr, int32_t(int32_t(1)<<23));  // limit code cost 72 bytes
-      // *ptr=limit( int32_t((-32767+RESXl)<<8), *ptr, int32_t((32767-RESXl)<<8));  // limit code cost 80 bytes
-#endif
 
-    } //endfor mixers
+      if (mode == e_perout_mode_normal && md->mltpx == MLTPX_REPL) {
+        for (const MixerPlanLine* l = firstLine; l < line; l++)
+          swOn[l->index].activeMix = false;
+      }
 
-    tick10ms = 0;
-    dirtyChannels &= passDirtyChannels;
+      mixChannelValue(&chans[md->destCh], dv, md->mltpx);
+    } //endfor mixer lines
 
-  } while (++pass < 5 && dirtyChannels);
+    pendingChannels &= ~channel_bit(chan.destCh);
+  } //endfor channels
 
   mixWarning = lv_mixWarning;
 }
@@ -1003,6 +1035,8 @@ void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms)
 #define MAX_ACT 0xffff
 uint8_t lastFlightMode = 255; // TODO reinit everything here when the model changes, no???
 
+uint8_t mixerFadingModes = 0;
+
 tmr10ms_t flightModeTransitionTime;
 uint8_t   flightModeTransitionLast = 255;
 
@@ -1014,6 +1048,8 @@ void evalMixes(uint8_t tick10ms)
   static uint16_t delta = 0;
   static uint16_t flightModesFade = 0;
 
+  curvesCacheUpdate();
+
   uint8_t fm = getFlightMode();
 
   if (lastFlightMode != fm) {
@@ -1051,18 +1087,28 @@ void evalMixes(uint8_t tick10ms)
   }
 
   int32_t weight = 0;
+  mixerFadingModes = 0;
   if (flightModesFade) {
     memclear(sum_chans512, sizeof(sum_chans512));
-    for (uint8_t p=0; p<MAX_FLIGHT_MODES; p++) {
+    for (uint8_t n=0; n<=MAX_FLIGHT_MODES; n++) {
+      // the active flight mode first, so that the other
+      // fading flight modes can reuse its shared mixer lines
+      uint8_t p = (n == 0 ? fm : n - 1);
+      if (n > 0 && p == fm)
+        continue;
       if (flightModesFade & (0x01 << p)) {
         mixerCurrentFlightMode = p;
+        if (p == fm) _fade_share_mode = MIXER_FADE_RECORD;
         evalFlightModeMixes(p==fm ? e_perout_mode_normal : e_perout_mode_inactive_flight_mode, p==fm ? tick10ms : 0);
+        if (p == fm) _fade_share_mode = MIXER_FADE_REUSE;
         for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++)
           sum_chans512[i] += limit<int32_t>(-0x6fff, chans[i] >> 4, 0x6fff) * fp_act[p];
         weight += fp_act[p];
+        mixerFadingModes++;
       }
     }
     assert(weight);
+    _fade_share_mode = MIXER_FADE_OFF;
     mixerCurrentFlightMode = fm;
   }
   else {
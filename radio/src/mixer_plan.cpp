@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "mixes.h"
+#include "mixer_plan.h"
+
+static MixerPlan _mixer_plan;
+static volatile bool _mixer_plan_valid = false;
+
+// Copy of the feedback loops of the last plan built, for the menus
+static bitfield_channels_t _mixer_loop_channels = 0;
+static bitfield_channels_t _mixer_loop_members[MAX_OUTPUT_CHANNELS];
+
+void mixerPlanInvalidate()
+{
+  _mixer_plan_valid = false;
+}
+
+// Switches whose state does not depend on the flight mode
+static bool isSwitchFlightModeIndependent(swsrc_t swtch)
+{
+  swtch = abs(swtch);
+  return swtch <= SWSRC_LAST_TRIM || swtch == SWSRC_ON || swtch == SWSRC_ONE;
+}
+
+// Sources whose value does not depend on the flight mode (inputs and
+// channels are checked at run time)
+static bool isSourceFlightModeIndependent(mixsrc_t srcRaw)
+{
+  if (srcRaw >= MIXSRC_FIRST_HELI && srcRaw <= MIXSRC_LAST_TRIM)
+    return false;
+  if (srcRaw >= MIXSRC_FIRST_LOGICAL_SWITCH &&
+      srcRaw <= MIXSRC_LAST_LOGICAL_SWITCH)
+    return false;
+  if (srcRaw >= MIXSRC_FIRST_GVAR && srcRaw <= MIXSRC_LAST_GVAR)
+    return false;
+  return true;
+}
+
+static void compileMixLine(MixerPlanLine& line, uint8_t idx, const MixData* md)
+{
+  line.index = idx;
+  line.source = MIXER_PLAN_SRC_VALUE;
+  line.srcIndex = 0;
+  line.flags = 0;
+
+  mixsrc_t srcRaw = md->srcRaw;
+  line.src = resolveMixSource(srcRaw);
+  if (srcRaw >= MIXSRC_FIRST_CH && srcRaw <= MIXSRC_LAST_CH) {
+    line.source = MIXER_PLAN_SRC_CHANNEL;
+    line.srcIndex = srcRaw - MIXSRC_FIRST_CH;
+  } else if (srcRaw >= MIXSRC_FIRST_INPUT && srcRaw <= MIXSRC_LAST_INPUT) {
+    line.source = MIXER_PLAN_SRC_INPUT;
+    line.srcIndex = srcRaw - MIXSRC_FIRST_INPUT;
+  } else if (srcRaw >= MIXSRC_FIRST_TRAINER && srcRaw <= MIXSRC_LAST_TRAINER) {
+    line.source = MIXER_PLAN_SRC_TRAINER;
+  }
+#if defined(LUA_MODEL_SCRIPTS)
+  else if (srcRaw >= MIXSRC_FIRST_LUA && srcRaw <= MIXSRC_LAST_LUA) {
+    line.source = MIXER_PLAN_SRC_LUA;
+  }
+#endif
+
+  if (md->swtch) line.flags |= MIXER_PLAN_HAS_SWITCH;
+  if (md->speedUp || md->speedDown) line.flags |= MIXER_PLAN_HAS_SPEED;
+  if (md->carryTrim == 0 &&
+      ((srcRaw >= MIXSRC_FIRST_STICK && srcRaw <= MIXSRC_LAST_STICK) ||
+       line.source == MIXER_PLAN_SRC_INPUT))
+    line.flags |= MIXER_PLAN_HAS_TRIM;
+
+  // the values below are the same for all flight modes
+  // unless they are pointing to a GVAR
+  line.weight = 0;
+#if defined(GVARS)
+  if (GV_IS_GV_VALUE(MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE))
+    line.flags |= MIXER_PLAN_GVAR_WEIGHT;
+  else
+#endif
+    line.weight = calc100to256_16Bits(GET_GVAR_PREC1(
+        MD_WEIGHT(md), GV_RANGELARGE_NEG, GV_RANGELARGE, 0));
+
+  line.offset = 0;
+#if defined(GVARS)
+  if (GV_IS_GV_VALUE(MD_OFFSET(md), GV_RANGELARGE_NEG, GV_RANGELARGE)) {
+    line.flags |= MIXER_PLAN_GVAR_OFFSET;
+  } else
+#endif
+  {
+    int32_t offset = GET_GVAR_PREC1(MD_OFFSET(md), GV_RANGELARGE_NEG,
+                                    GV_RANGELARGE, 0);
+    if (offset)
+      line.offset = divRoundClosest(calc100toRESX_16Bits(offset), 10) << 8;
+  }
+
+  bool curveGVar = false;
+#if defined(GVARS)
+  if (md->curve.type == CURVE_REF_DIFF || md->curve.type == CURVE_REF_EXPO)
+    curveGVar = GV_IS_GV_VALUE(md->curve.value, -100, 100);
+#endif
+
+  // delays are checked at run time: they only apply to the active
+  // flight mode; speeds depend on the evaluation order
+  if (md->flightModes == 0 && !curveGVar &&
+      !(line.flags & (MIXER_PLAN_GVAR_WEIGHT | MIXER_PLAN_GVAR_OFFSET |
+                      MIXER_PLAN_HAS_SPEED)) &&
+      isSwitchFlightModeIndependent(md->swtch) &&
+      isSourceFlightModeIndependent(srcRaw))
+    line.flags |= MIXER_PLAN_FM_SHARED;
+}
+
+// Bit 'n' of deps[ch] is set when a mixer line of channel 'ch'
+// uses channel 'n' as its source. A channel using itself is
+// not a dependency: it always reads its previous value.
+static void getChannelDependencies(bitfield_channels_t* deps)
+{
+  memclear(deps, MAX_OUTPUT_CHANNELS * sizeof(bitfield_channels_t));
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData* md = mixAddress(i);
+    if (md->srcRaw == 0) {
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+    }
+    if (md->srcRaw >= MIXSRC_FIRST_CH && md->srcRaw <= MIXSRC_LAST_CH) {
+      uint8_t srcCh = md->srcRaw - MIXSRC_FIRST_CH;
+      if (srcCh != md->destCh)
+        deps[md->destCh] |= (bitfield_channels_t)1 << srcCh;
+    }
+  }
+}
+
+// Transitive closure of the dependencies (Warshall):
+// bit 'n' of reach[ch] is set when 'ch' depends on 'n'
+// directly or through other channels.
+static void getChannelReachability(bitfield_channels_t* reach,
+                                   const bitfield_channels_t* deps)
+{
+  memcpy(reach, deps, MAX_OUTPUT_CHANNELS * sizeof(bitfield_channels_t));
+
+  for (uint8_t k = 0; k < MAX_OUTPUT_CHANNELS; k++) {
+    bitfield_channels_t bit = (bitfield_channels_t)1 << k;
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      if (reach[ch] & bit) reach[ch] |= reach[k];
+    }
+  }
+}
+
+// Channels belonging to the same feedback loop as 'ch' (including 'ch')
+static bitfield_channels_t getLoopMembers(const bitfield_channels_t* reach,
+                                          uint8_t ch)
+{
+  bitfield_channels_t members = (bitfield_channels_t)1 << ch;
+  for (uint8_t n = 0; n < MAX_OUTPUT_CHANNELS; n++) {
+    if ((reach[ch] & ((bitfield_channels_t)1 << n)) &&
+        (reach[n] & ((bitfield_channels_t)1 << ch)))
+      members |= (bitfield_channels_t)1 << n;
+  }
+  return members;
+}
+
+static bitfield_channels_t getLoopChannels(const bitfield_channels_t* reach)
+{
+  bitfield_channels_t loops = 0;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    if (reach[ch] & ((bitfield_channels_t)1 << ch))
+      loops |= (bitfield_channels_t)1 << ch;
+  }
+  return loops;
+}
+
+// Sort the channels so that each channel comes after the channels
+// it uses as a source.
+//
+// The channels of a feedback loop are computed together, in channel
+// order, once all the channels they depend on outside of the loop
+// are ready. Within the loop, a channel used as a source before
+// being computed provides its value from the previous mixer cycle
+// (one cycle delay). Channels depending on a loop are computed
+// after the whole loop.
+static void sortMixerPlanChannels(MixerPlan& plan,
+                                  const MixerPlanChannel* byChannel,
+                                  bitfield_channels_t usedChannels)
+{
+  bitfield_channels_t deps[MAX_OUTPUT_CHANNELS];
+  bitfield_channels_t reach[MAX_OUTPUT_CHANNELS];
+  getChannelDependencies(deps);
+  getChannelReachability(reach, deps);
+
+  // the loop of each channel, and the channels the whole loop uses
+  bitfield_channels_t loops[MAX_OUTPUT_CHANNELS];
+  bitfield_channels_t loopDeps[MAX_OUTPUT_CHANNELS];
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    loops[ch] = getLoopMembers(reach, ch);
+    loopDeps[ch] = 0;
+    for (uint8_t n = 0; n < MAX_OUTPUT_CHANNELS; n++) {
+      if (loops[ch] & ((bitfield_channels_t)1 << n)) loopDeps[ch] |= deps[n];
+    }
+  }
+
+  plan.loopChannels = getLoopChannels(reach);
+  plan.channelsCount = 0;
+
+  _mixer_loop_channels = plan.loopChannels;
+  memcpy(_mixer_loop_members, loops, sizeof(loops));
+
+  // channels without mixer lines are always ready
+  bitfield_channels_t done = ~usedChannels;
+
+  while (~done) {
+    bitfield_channels_t members = 0;
+
+    for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+      if (done & ((bitfield_channels_t)1 << ch)) continue;
+
+      if (!(loopDeps[ch] & ~done & ~loops[ch])) {
+        members = loops[ch];
+        break;
+      }
+    }
+
+    // as loops are merged, the graph has no cycle left
+    // and there is always a channel or a loop ready
+    if (!members) members = ~done;
+
+    for (uint8_t n = 0; n < MAX_OUTPUT_CHANNELS; n++) {
+      if (members & ((bitfield_channels_t)1 << n)) {
+        plan.channels[plan.channelsCount++] = byChannel[n];
+      }
+    }
+    done |= members;
+  }
+}
+
+static void buildMixerPlan(MixerPlan& plan)
+{
+  MixerPlanChannel byChannel[MAX_OUTPUT_CHANNELS];
+  memclear(byChannel, sizeof(byChannel));
+
+  // count the lines of each channel
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData* md = mixAddress(i);
+    if (md->srcRaw == 0) {
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+    }
+    byChannel[md->destCh].linesCount++;
+    count++;
+  }
+
+  // lines are stored grouped by channel, in mixer lines order
+  bitfield_channels_t usedChannels = 0;
+  uint8_t first = 0;
+  for (uint8_t ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    byChannel[ch].destCh = ch;
+    byChannel[ch].firstLine = first;
+    first += byChannel[ch].linesCount;
+    if (byChannel[ch].linesCount) {
+      usedChannels |= (bitfield_channels_t)1 << ch;
+      byChannel[ch].linesCount = 0;
+    }
+  }
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData* md = mixAddress(i);
+    if (md->srcRaw == 0) {
+#if defined(COLORLCD)
+      continue;
+#else
+      break;
+#endif
+    }
+    MixerPlanChannel& chan = byChannel[md->destCh];
+    compileMixLine(plan.lines[chan.firstLine + chan.linesCount], i, md);
+    chan.linesCount++;
+  }
+
+  plan.linesCount = count;
+  plan.usedChannels = usedChannels;
+  sortMixerPlanChannels(plan, byChannel, usedChannels);
+}
+
+bitfield_channels_t mixerGetLoopChannels()
+{
+  return _mixer_loop_channels;
+}
+
+bool isMixLineInLoop(uint8_t idx)
+{
+  MixData* md = mixAddress(idx);
+  if (md->srcRaw < MIXSRC_FIRST_CH || md->srcRaw > MIXSRC_LAST_CH)
+    return false;
+
+  uint8_t srcCh = md->srcRaw - MIXSRC_FIRST_CH;
+  if (srcCh == md->destCh)
+    return false;
+
+  // the source is in the same loop as the destination channel
+  return _mixer_loop_members[md->destCh] & ((bitfield_channels_t)1 << srcCh);
+}
+
+const MixerPlan& mixerPlanGet()
+{
+#if defined(SIMU)
+  if (modelCachesAlwaysRebuild) _mixer_plan_valid = false;
+#endif
+
+  if (!_mixer_plan_valid) {
+    // set first: an invalidation while building
+    // will trigger another build on next call
+    _mixer_plan_valid = true;
+    buildMixerPlan(_mixer_plan);
+  }
+
+  return _mixer_plan;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "dataconstants.h"
+#include "opentx_types.h"
+#include "mixer_sources.h"
+
+// The mixer plan is a compiled view of g_model.mixData:
+//  - only the used mixer lines, grouped by destination channel,
+//  - the kind of each line source resolved once, as well as the
+//    source itself (see mixer_sources.h),
+//  - constant weights / offsets already scaled,
+//  - the channels sorted so that channels used as a source
+//    by other channels are computed first,
+//  - the lines which do not depend on the flight mode, whose values
+//    can be shared between the flight modes during a fade.
+//
+// Channels using each other as a source (feedback loops) are computed
+// together: the channel read before being computed provides its value
+// from the previous mixer cycle. These loops are reported in the mixer
+// page.
+//
+// It is rebuilt lazily by the mixer after mixerPlanInvalidate(),
+// which is triggered by storageDirty(EE_MODEL).
+
+enum MixerPlanSource {
+  MIXER_PLAN_SRC_VALUE,    // any source read with getValue()
+  MIXER_PLAN_SRC_CHANNEL,  // output of another channel
+  MIXER_PLAN_SRC_INPUT,    // input (expo) line
+  MIXER_PLAN_SRC_TRAINER,  // disabled while the trainer is not connected
+  MIXER_PLAN_SRC_LUA,      // disabled while the script is not running
+};
+
+enum MixerPlanLineFlags {
+  MIXER_PLAN_GVAR_WEIGHT = (1 << 0),  // weight must be resolved at run time
+  MIXER_PLAN_GVAR_OFFSET = (1 << 1),  // offset must be resolved at run time
+  MIXER_PLAN_HAS_SWITCH = (1 << 2),
+  MIXER_PLAN_HAS_SPEED = (1 << 3),
+  MIXER_PLAN_HAS_TRIM = (1 << 4),     // the source trim is added
+  // the line settings and source kind are the same in all flight modes:
+  // its value only changes with the source value and the trims
+  MIXER_PLAN_FM_SHARED = (1 << 5),
+};
+
+struct MixerPlanLine {
+  uint8_t index;       // index in g_model.mixData
+  uint8_t source;      // MixerPlanSource
+  uint8_t srcIndex;    // channel or input index
+  uint8_t flags;       // MixerPlanLineFlags
+  int16_t weight;      // already scaled to 256 (unless MIXER_PLAN_GVAR_WEIGHT)
+  MixSourceRef src;    // md->srcRaw
+  int32_t offset;      // already scaled to RESX << 8 (unless MIXER_PLAN_GVAR_OFFSET)
+};
+
+struct MixerPlanChannel {
+  uint8_t destCh;
+  uint8_t firstLine;   // index in MixerPlan::lines
+  uint8_t linesCount;
+};
+
+struct MixerPlan {
+  MixerPlanLine lines[MAX_MIXERS];
+  uint8_t linesCount;
+
+  // channels with at least one mixer line, in evaluation order
+  MixerPlanChannel channels[MAX_OUTPUT_CHANNELS];
+  uint8_t channelsCount;
+  bitfield_channels_t usedChannels;
+
+  // channels belonging to a feedback loop
+  bitfield_channels_t loopChannels;
+};
+
+// Mark the plan as outdated: it will be rebuilt
+// before the next mixer evaluation.
+void mixerPlanInvalidate();
+
+// Return the current plan, rebuilding it first if needed.
+// Only to be used by the mixer evaluation.
+const MixerPlan& mixerPlanGet();
+
+// Channels belonging to a feedback loop, from the last plan built
+// by the mixer (can be used from any task).
+bitfield_channels_t mixerGetLoopChannels();
+
+// Return true if the mixer line 'idx' uses a channel which depends
+// on its own destination channel (from the last plan built as well).
+bool isMixLineInLoop(uint8_t idx);
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "opentx.h"
+#include "mixer_sources.h"
+
+struct MixSourceRange {
+  uint16_t first;
+  uint8_t category;
+};
+
+// The source ranges, sorted
+static constexpr MixSourceRange _mixsrc_ranges[] = {
+  { MIXSRC_NONE, MIXSRC_CAT_NONE },
+  { MIXSRC_FIRST_INPUT, MIXSRC_CAT_INPUT },
+#if defined(LUA_INPUTS)
+  { MIXSRC_FIRST_LUA, MIXSRC_CAT_LUA },
+#endif
+  { MIXSRC_FIRST_STICK, MIXSRC_CAT_STICK },
+  { MIXSRC_FIRST_POT, MIXSRC_CAT_POT },
+#if defined(IMU)
+  { MIXSRC_TILT_X, MIXSRC_CAT_TILT },
+#endif
+#if defined(PCBHORUS)
+#if defined(SPACEMOUSE)
+  { MIXSRC_FIRST_SPACEMOUSE, MIXSRC_CAT_SPACEMOUSE },
+#else
+  { MIXSRC_FIRST_SPACEMOUSE, MIXSRC_CAT_NONE },
+#endif
+#endif
+  { MIXSRC_MIN, MIXSRC_CAT_MIN },
+  { MIXSRC_MAX, MIXSRC_CAT_MAX },
+  { MIXSRC_FIRST_HELI, MIXSRC_CAT_HELI },
+  { MIXSRC_FIRST_TRIM, MIXSRC_CAT_TRIM },
+  { MIXSRC_FIRST_SWITCH, MIXSRC_CAT_SWITCH },
+  { MIXSRC_FIRST_LOGICAL_SWITCH, MIXSRC_CAT_LOGICAL_SWITCH },
+  { MIXSRC_FIRST_TRAINER, MIXSRC_CAT_TRAINER },
+  { MIXSRC_FIRST_CH, MIXSRC_CAT_CH },
+  { MIXSRC_FIRST_GVAR, MIXSRC_CAT_GVAR },
+  { MIXSRC_TX_VOLTAGE, MIXSRC_CAT_TX_VOLTAGE },
+  { MIXSRC_TX_TIME, MIXSRC_CAT_TX_TIME },
+  { MIXSRC_FIRST_TIMER, MIXSRC_CAT_TIMER },
+  { MIXSRC_FIRST_TELEM, MIXSRC_CAT_TELEM },
+  // end of the last range
+  { MIXSRC_LAST_TELEM + 1, MIXSRC_CAT_NONE },
+};
+
+static_assert(3 * MAX_TELEMETRY_SENSORS <= 256 &&
+                  MAX_SCRIPTS * MAX_SCRIPT_OUTPUTS <= 256,
+              "MixSourceRef::index is too small");
+
+// The range of the first source of each block of sources, so that
+// a source is found in the ranges with only a few comparisons
+#define MIXSRC_BLOCK_SHIFT  4
+
+static constexpr uint8_t mixSourceBlockRange(mixsrc_t first, uint8_t range = 0)
+{
+  return _mixsrc_ranges[range + 1].first <= first
+             ? mixSourceBlockRange(first, range + 1)
+             : range;
+}
+
+// Expands to the blocks 0 .. N-1 at compile time
+template <unsigned N, unsigned... Blocks>
+struct MixSourceBlocks : MixSourceBlocks<N - 1, N - 1, Blocks...> {
+};
+
+template <unsigned... Blocks>
+struct MixSourceBlocks<0, Blocks...> {
+  static constexpr uint8_t ranges[] = {
+      mixSourceBlockRange(Blocks << MIXSRC_BLOCK_SHIFT)...};
+};
+
+template <unsigned... Blocks>
+constexpr uint8_t MixSourceBlocks<0, Blocks...>::ranges[];
+
+typedef MixSourceBlocks<(MIXSRC_LAST_TELEM >> MIXSRC_BLOCK_SHIFT) + 1>
+    MixSourceBlockTable;
+
+MixSourceRef resolveMixSource(mixsrc_t i)
+{
+  if (i > MIXSRC_LAST_TELEM)
+    return { MIXSRC_CAT_NONE, 0 };
+
+  uint8_t range = MixSourceBlockTable::ranges[i >> MIXSRC_BLOCK_SHIFT];
+  while (_mixsrc_ranges[range + 1].first <= i)
+    range++;
+
+  const MixSourceRange& r = _mixsrc_ranges[range];
+  return { r.category, (uint8_t)(i - r.first) };
+}
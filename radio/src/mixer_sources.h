@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "opentx_types.h"
+
+// A mixer source resolved to its category and its index in this
+// category, so that its value can be read without going through all
+// the source ranges each time (see getValue(MixSourceRef)).
+//
+// The resolution only depends on the firmware options: it can be
+// kept as long as the source number does not change.
+
+enum MixSourceCategory {
+  MIXSRC_CAT_NONE,            // MIXSRC_NONE and unused sources
+  MIXSRC_CAT_INPUT,
+  MIXSRC_CAT_LUA,
+  MIXSRC_CAT_STICK,
+  MIXSRC_CAT_POT,
+  MIXSRC_CAT_TILT,
+  MIXSRC_CAT_SPACEMOUSE,
+  MIXSRC_CAT_MIN,
+  MIXSRC_CAT_MAX,
+  MIXSRC_CAT_HELI,
+  MIXSRC_CAT_TRIM,
+  MIXSRC_CAT_SWITCH,
+  MIXSRC_CAT_LOGICAL_SWITCH,
+  MIXSRC_CAT_TRAINER,
+  MIXSRC_CAT_CH,
+  MIXSRC_CAT_GVAR,
+  MIXSRC_CAT_TX_VOLTAGE,
+  MIXSRC_CAT_TX_TIME,         // TX_TIME and the following spare sources
+  MIXSRC_CAT_TIMER,
+  MIXSRC_CAT_TELEM,           // 3 sources per sensor (value, min, max)
+};
+
+struct MixSourceRef {
+  uint8_t category;   // MixSourceCategory
+  uint8_t index;      // index in the category
+};
+
+MixSourceRef resolveMixSource(mixsrc_t i);
+
+// Same as getValue(mixsrc_t), for an already resolved source
+getvalue_t getValue(MixSourceRef src, bool* valid = nullptr);
@@ -73,6 +73,7 @@ Clipboard clipboard;
 GlobalData globalData;
 
 uint32_t maxMixerDuration; // microseconds
+uint32_t maxMixerFadeDuration; // microseconds, during flight mode fades
 
 constexpr uint8_t HEART_TIMER_10MS = 0x01;
 uint8_t heartbeat;
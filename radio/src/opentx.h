@@ -272,6 +272,8 @@ extern uint32_t availableMemory();
 
 void evalFlightModeMixes(uint8_t mode, uint8_t tick10ms);
 void evalMixes(uint8_t tick10ms);
+// number of flight modes evaluated by the last evalMixes() when fading
+extern uint8_t mixerFadingModes;
 void doMixerCalculations();
 void doMixerPeriodicUpdates();
 
@@ -280,6 +282,7 @@ extern uint8_t currentBacklightBright;
 void perMain();
 
 getvalue_t getValue(mixsrc_t i, bool* valid = nullptr);
+#include "mixer_sources.h"
 
 int8_t getMovedSource(uint8_t min);
 #define GET_MOVED_SOURCE(min, max) getMovedSource(min)
@@ -289,6 +289,15 @@ static void dsmpProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* l
   processSpektrumTelemetryData(module, data, buffer, *len);
 }
 
+static void dsmpProcessBuffer(void* ctx, const uint8_t* data, uint32_t size,
+                              uint8_t* buffer, uint8_t* len)
+{
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+
+  processSpektrumTelemetryBuffer(module, data, size, buffer, *len);
+}
+
 // No telemetry
 const etx_proto_driver_t DSM2Driver = {
   .protocol = PROTOCOL_CHANNELS_DSM2,
@@ -306,6 +315,7 @@ const etx_proto_driver_t DSMPDriver = {
   .deinit = dsmDeInit,
   .sendPulses = dsmpSendPulses,
   .processData = dsmpProcessData,
+  .processBuffer = dsmpProcessBuffer,
   .processFrame = nullptr,
   .onConfigChange = nullptr,
 };
@@ -246,12 +246,61 @@ static void ghostProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t*
   }
 }
 
+// Same as ghostProcessData() for each byte, but the frames are copied
+// at once, their length being known after the first 2 bytes
+static void ghostProcessBuffer(void* ctx, const uint8_t* data, uint32_t size,
+                               uint8_t* buffer, uint8_t* len)
+{
+  while (size > 0) {
+    if (*len == 0) {
+      auto start = (const uint8_t*)memchr(data, GHST_ADDR_RADIO, size);
+      if (!start) {
+        TRACE("[GH] address 0x%02X error", data[0]);
+        return;
+      }
+      size -= start - data;
+      data = start;
+    }
+
+    uint32_t frameLength = 2;
+    if (*len >= 2) {
+      frameLength = buffer[1] + 2;
+      if (frameLength <= 4 || frameLength > TELEMETRY_RX_PACKET_SIZE) {
+        // as byte per byte, the buffer is filled, then the next byte dropped
+        if (*len == TELEMETRY_RX_PACKET_SIZE) {
+          TRACE("[GH] array size %d error", *len);
+          *len = 0;
+          data++;
+          size--;
+          continue;
+        }
+        frameLength = TELEMETRY_RX_PACKET_SIZE;
+      }
+    }
+
+    uint32_t count = frameLength - *len;
+    if (count > size) count = size;
+    memcpy(buffer + *len, data, count);
+    *len += count;
+    data += count;
+    size -= count;
+
+    if (*len > 4 && *len == buffer[1] + 2) {
+      auto mod_st = (etx_module_state_t*)ctx;
+      auto module = modulePortGetModule(mod_st);
+      processGhostTelemetryFrame(module, buffer, *len);
+      *len = 0;
+    }
+  }
+}
+
 const etx_proto_driver_t GhostDriver = {
   .protocol = PROTOCOL_CHANNELS_GHOST,
   .init = ghostInit,
   .deinit = ghostDeInit,
   .sendPulses = ghostSendPulses,
   .processData = ghostProcessData,
+  .processBuffer = ghostProcessBuffer,
   .processFrame = nullptr,
   .onConfigChange = nullptr,
 };
@@ -408,12 +408,22 @@ static void pxx1ProcessData(void* ctx, uint8_t data, uint8_t* buffer, uint8_t* l
   processFrskySportTelemetryData(module, data, buffer, *len);
 }
 
+static void pxx1ProcessBuffer(void* ctx, const uint8_t* data, uint32_t size,
+                              uint8_t* buffer, uint8_t* len)
+{
+  auto mod_st = (etx_module_state_t*)ctx;
+  auto module = modulePortGetModule(mod_st);
+
+  processFrskySportTelemetryBuffer(module, data, size, buffer, *len);
+}
+
 const etx_proto_driver_t Pxx1Driver = {
   .protocol = PROTOCOL_CHANNELS_PXX1,
   .init = pxx1Init,
   .deinit = pxx1DeInit,
   .sendPulses = pxx1SendPulses,
   .processData = pxx1ProcessData,
+  .processBuffer = pxx1ProcessBuffer,
   .processFrame = nullptr,
   .onConfigChange = nullptr,
 };
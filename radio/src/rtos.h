@@ -107,12 +107,11 @@ extern "C++" {
 
   #define TASK_FUNCTION(task)           void* task(void *)
 
+  void simuCreateTask(pthread_t &taskId, void * (*task)(void *), const char * name);
+
   inline void RTOS_CREATE_TASK(pthread_t &taskId, void * (*task)(void *), const char * name)
   {
-    pthread_create(&taskId, nullptr, task, nullptr);
-#ifdef __linux__
-    pthread_setname_np(taskId, name);
-#endif
+    simuCreateTask(taskId, task, name);
   }
 
   template <int SIZE>
@@ -26,6 +26,11 @@
 #include "hal/storage.h"
 
 #include "opentx.h"
+#include "file_sink.h"
+
+#if defined(DISK_CACHE)
+#include "disk_cache.h"
+#endif
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
@@ -495,7 +500,11 @@ static bool _g_FATFS_init = false;
 static FATFS g_FATFS_Obj __DMA; // this is in uninitialised section !!!
 
 #if defined(LOG_TELEMETRY)
+#define TELEMETRY_LOG_CHUNK_SIZE  1024
 FIL g_telemetryFile = {};
+static uint8_t _telemetry_log_buffer[2 * TELEMETRY_LOG_CHUNK_SIZE] __DMA;
+FileSink telemetryLogSink("telemetry", &g_telemetryFile, _telemetry_log_buffer,
+                          TELEMETRY_LOG_CHUNK_SIZE);
 #endif
 
 #if defined(LOG_BLUETOOTH)
@@ -519,15 +528,18 @@ void sdMount()
   storagePreMountHook();
   
   if (f_mount(&g_FATFS_Obj, "", 1) == FR_OK) {
+#if defined(DISK_CACHE)
+    // keep the FAT (and FAT16 root directory) sectors in cache
+    diskCache.setPinnedSectors(g_FATFS_Obj.fatbase, g_FATFS_Obj.database);
+#endif
+
     // call sdGetFreeSectors() now because f_getfree() takes a long time first time it's called
     _g_FATFS_init = true;
     sdGetFreeSectors();
 
 #if defined(LOG_TELEMETRY)
-    f_open(&g_telemetryFile, LOGS_PATH "/telemetry.log", FA_OPEN_ALWAYS | FA_WRITE);
-    if (f_size(&g_telemetryFile) > 0) {
-      f_lseek(&g_telemetryFile, f_size(&g_telemetryFile)); // append
-    }
+    telemetryLogSink.open(LOGS_PATH "/telemetry.log",
+                          FA_OPEN_ALWAYS | FA_WRITE | FA_OPEN_APPEND);
 #endif
 
 #if defined(LOG_BLUETOOTH)
@@ -550,7 +562,7 @@ void sdDone()
     audioQueue.stopSD();
 
 #if defined(LOG_TELEMETRY)
-    f_close(&g_telemetryFile);
+    telemetryLogSink.close();
 #endif
 
 #if defined(LOG_BLUETOOTH)
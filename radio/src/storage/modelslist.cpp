@@ -136,8 +136,7 @@ ModelsVector ModelMap::getUnlabeledModels()
 {
   ModelsVector unlabeledModels;
   for (auto model : modelslist) {
-    if (modelslabels.getLabelsByModel(model).size() == 0)
-      unlabeledModels.emplace_back(model);
+    if (!model->labels.any()) unlabeledModels.emplace_back(model);
   }
   sortModelsBy(unlabeledModels, _sortOrder);
   return unlabeledModels;
@@ -167,8 +166,8 @@ ModelsVector ModelMap::getModelsByLabel(const std::string &lbl)
   int index = getIndexByLabel(lbl);
   if (index < 0) return ModelsVector();
   ModelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    if (it->first == index) rv.push_back(it->second);
+  for (auto model : modelslist) {
+    if (model->labels.test(index)) rv.push_back(model);
   }
   sortModelsBy(rv, _sortOrder);
   return rv;
@@ -185,24 +184,19 @@ ModelsVector ModelMap::getModelsByLabel(const std::string &lbl)
 ModelsVector ModelMap::getModelsByLabels(const LabelsVector &lbls)
 {
   bool addunlabeled = false;
-  // Build a list of the requested indexes
-  std::vector<int> idxvect;
+  // Build the mask of the requested labels
+  LabelsMask mask;
   for (const auto &lbl : lbls) {
     if (lbl == STR_UNLABELEDMODEL) addunlabeled = true;
     int index = getIndexByLabel(lbl);
-    if (index >= 0) idxvect.push_back(index);
+    if (index >= 0) mask.set(index);
   }
 
   ModelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    for (auto idx : idxvect) {
-      if (it->first == idx) rv.push_back(it->second);
-    }
-  }
-
-  if (addunlabeled) {
-    ModelsVector unlabeled = getUnlabeledModels();
-    rv.insert(rv.end(), unlabeled.begin(), unlabeled.end());
+  for (auto model : modelslist) {
+    if (model->labels.intersects(mask) ||
+        (addunlabeled && !model->labels.any()))
+      rv.push_back(model);
   }
 
   sortModelsBy(rv, _sortOrder);
@@ -227,19 +221,17 @@ ModelsVector ModelMap::getModelsInLabels(const LabelsVector &lbls)
 
   ModelsVector rv;
 
-  for (const auto &mdl : modelslist) {
-    bool hasAllLabels = true;
-    LabelsVector mdllables = getLabelsByModel(mdl);
-    for (const auto &lbl : lbls) {
-      if (lbl == STR_UNLABELEDMODEL)  // If requesting unlabeled model ignore it
-        break;
-      if (std::find(mdllables.begin(), mdllables.end(), lbl) ==
-          mdllables.end()) {
-        hasAllLabels = false;
-        break;
-      }
-    }
-    if (hasAllLabels) rv.push_back(mdl);
+  LabelsMask mask;
+  for (const auto &lbl : lbls) {
+    if (lbl == STR_UNLABELEDMODEL)  // If requesting unlabeled model ignore it
+      break;
+    int index = getIndexByLabel(lbl);
+    if (index < 0) return rv;  // No model can have this label
+    mask.set(index);
+  }
+
+  for (auto model : modelslist) {
+    if (model->labels.contains(mask)) rv.push_back(model);
   }
 
   sortModelsBy(rv, _sortOrder);
@@ -257,10 +249,8 @@ LabelsVector ModelMap::getLabelsByModel(ModelCell *mdl)
 {
   if (mdl == nullptr) return LabelsVector();
   LabelsVector rv;
-  for (auto it = begin(); it != end(); ++it) {
-    if (it->second == mdl) {
-      rv.push_back(getLabelByIndex(it->first));
-    }
+  for (unsigned i = 0; i < labels.size(); i++) {
+    if (mdl->labels.test(i)) rv.push_back(labels[i]);
   }
   return rv;
 }
@@ -277,13 +267,10 @@ LabelsVector ModelMap::getLabelsByModel(ModelCell *mdl)
 std::map<std::string, bool> ModelMap::getSelectedLabels(ModelCell *cell)
 {
   std::map<std::string, bool> rval;
-  for (auto lbl : labels) {  // Add all labels
-    if (lbl == "") continue;
-    rval[lbl] = false;
-  }
-  LabelsVector modlbl = getLabelsByModel(cell);
-  for (const auto &ml : modlbl) {  // Set to true if selected by the model
-    rval[ml] = true;
+  for (unsigned i = 0; i < labels.size(); i++) {
+    if (labels[i] == "") continue;
+    // Set to true if selected by the model
+    rval[labels[i]] = cell && cell->labels.test(i);
   }
   return rval;
 }
@@ -299,11 +286,9 @@ std::map<std::string, bool> ModelMap::getSelectedLabels(ModelCell *cell)
 
 bool ModelMap::isLabelSelected(const std::string &label, ModelCell *cell)
 {
-  auto lbm = getLabelsByModel(cell);
-  if (std::find(lbm.begin(), lbm.end(), label) == lbm.end()) {
-    return false;
-  }
-  return true;
+  int index = getIndexByLabel(label);
+  if (index < 0 || cell == nullptr) return false;
+  return cell->labels.test(index);
 }
 
 /**
@@ -325,8 +310,9 @@ LabelsVector ModelMap::getLabels()
 /**
  * @brief Adds a label
  * @details  Checks if the label already exists. If it does it returns the
- *           index to it. If label doesn't exist it adds it at the end of the
- *           list and returns the new index
+ *           index to it. If label doesn't exist it adds it in the slot of a
+ *           removed label, or at the end of the list, and returns the new
+ *           index
  *           Won't allow creation of the special case label "Unlabeled" STR_UNLABELEDMODEL
  *
  * @param lbl Adds a label to the list
@@ -346,10 +332,18 @@ int ModelMap::addLabel(std::string lbl)
   // Returns the index to the label
   int ind = getIndexByLabel(lbl);
   if (ind < 0) {
-    labels.push_back(lbl);
+    // Reuse the slot of a removed label, no model has it anymore
+    ind = getIndexByLabel("");
+    if (ind >= 0) {
+      labels[ind] = lbl;
+      filtlbls.erase(ind);
+      for (auto model : modelslist) model->labels.reset(ind);
+    } else {
+      labels.push_back(lbl);
+      ind = labels.size() - 1;
+    }
     setDirty();
     TRACE_LABELS("Added a label %s", lbl.c_str());
-    return labels.size() - 1;
   }
   return ind;
 }
@@ -375,9 +369,10 @@ bool ModelMap::addLabelToModel(const std::string &lbl, ModelCell *cell,
     return true;
   }
 
-  setDirty();
   int labelindex = addLabel(lbl);
-  insert(std::pair<int, ModelCell *>(labelindex, cell));
+  if (labelindex < 0) return true;
+  setDirty();
+  cell->labels.set(labelindex);
 
   if (update) updateModelFile(cell);  // Write labels into model
 
@@ -523,10 +518,8 @@ bool ModelMap::removeLabelFromModel(const std::string &label, ModelCell *cell,
   int lblind = getIndexByLabel(label);
   if (lblind < 0) return true;
   bool rv = true;
-  // Erase items that match in the map
-  for (ModelMap::const_iterator itr = cbegin(); itr != cend();) {
-    itr = (itr->first == lblind && itr->second == cell) ? erase(itr)
-                                                        : std::next(itr);
+  if (cell->labels.test(lblind)) {
+    cell->labels.reset(lblind);
     setDirty();
     rv = false;
   }
@@ -592,19 +585,20 @@ bool ModelMap::moveLabelTo(unsigned curind, unsigned newind)
 
   std::swap(labels[curind], labels[newind]);
 
-  ModelMap newmap;
-  newmap.labels = labels;
-
-  for (auto &mm : modelslabels) {
-    uint16_t ind = mm.first;
-    if (ind == curind)
-      ind = newind;
-    else if (ind == newind)
-      ind = curind;
-    newmap.insert(std::make_pair(ind, mm.second));
+  for (auto model : modelslist) {
+    bool cur = model->labels.test(curind);
+    bool nw = model->labels.test(newind);
+    model->labels.reset(curind);
+    model->labels.reset(newind);
+    if (cur) model->labels.set(newind);
+    if (nw) model->labels.set(curind);
   }
 
-  modelslabels = newmap;
+  // Keep the same labels filtered
+  bool curflt = filtlbls.erase(curind);
+  bool newflt = filtlbls.erase(newind);
+  if (curflt) filtlbls.insert(newind);
+  if (newflt) filtlbls.insert(curind);
 
   modelslist.save(labels);
   setDirty();
@@ -773,18 +767,10 @@ std::string ModelMap::getBulletLabelString(ModelCell *curmod, const char *noresu
 
 bool ModelMap::removeModels(ModelCell *cell)
 {
-  bool rv = true;
-  // Erase items that match in the map
-  for (ModelMap::const_iterator itr = cbegin(); itr != cend();) {
-    if (itr->second == cell) {
-      itr = erase(itr);
-      setDirty();
-      rv = false;
-    } else {
-      itr = std::next(itr);
-    }
-  }
-  return rv;
+  if (!cell->labels.any()) return true;
+  cell->labels.clear();
+  setDirty();
+  return false;
 }
 
 /**
@@ -865,6 +851,17 @@ void ModelMap::sortModelsBy(ModelsVector &mv, ModelsSortBy sortby)
   }
 }
 
+/**
+ * @brief Removes all the labels
+ */
+
+void ModelMap::clear()
+{
+  _isDirty = true;
+  labels.clear();
+  for (auto model : modelslist) model->labels.clear();
+}
+
 /**
  * @brief Sets the ModelMap to dirty.
  * @details Causes labels.yml to be written after a delay in
@@ -989,6 +986,247 @@ char *FILInfoToHexStr(char buffer[17], FILINFO *finfo)
   return buffer;
 }
 
+// labels.idx: binary copy of labels.yml, written with it and only used
+// while labels.yml has not changed. Loading it avoids parsing labels.yml,
+// and the models labels are stored as bitsets of the labels indexes.
+
+#define LABELS_INDEX_MAGIC    "ETXI"
+#define LABELS_INDEX_VERSION  1
+
+PACK(struct LabelsIndexHeader {
+  char magic[4];
+  uint8_t version;
+  uint8_t sortOrder;
+  uint16_t recordSize;
+  char labelsHash[FILE_HASH_LENGTH];  // labels.yml hash
+  uint16_t labelsCount;
+  uint16_t modelsCount;
+});
+
+// followed by (labelsCount + 31) / 32 words of labels bitset
+PACK(struct LabelsIndexRecord {
+  char filename[LEN_MODEL_FILENAME];
+  char hash[FILE_HASH_LENGTH];
+  char name[LEN_MODEL_NAME];
+#if LEN_BITMAP_NAME > 0
+  char bitmap[LEN_BITMAP_NAME];
+#endif
+  int32_t lastOpened;
+  uint8_t modelId[NUM_MODULES];
+  SimpleModuleData moduleData[NUM_MODULES];
+});
+
+// labels: uint8_t length, uint8_t selected, name (not '\0' terminated)
+#define LABELS_INDEX_LABEL_HEADER_SIZE  2
+
+static bool labelsListHash(char hash[FILE_HASH_LENGTH + 1])
+{
+  FILINFO fno;
+  if (f_stat(LABELSLIST_YAML_PATH, &fno) != FR_OK) return false;
+  FILInfoToHexStr(hash, &fno);
+  return true;
+}
+
+ModelsList::filedat *ModelsList::findFileHash(const char *name)
+{
+  // fileHashInfo is sorted by name
+  auto it = std::lower_bound(
+      fileHashInfo.begin(), fileHashInfo.end(), name,
+      [](const filedat &f, const char *name) { return f.name < name; });
+  if (it != fileHashInfo.end() && it->name == name) return &(*it);
+  return nullptr;
+}
+
+/**
+ * @brief Loads the Labels and Models from labels.idx, if it matches labels.yml
+ *
+ * @return true On success
+ * @return false labels.yml has to be parsed
+ */
+
+bool ModelsList::loadIndex()
+{
+  char hash[FILE_HASH_LENGTH + 1];
+  if (!labelsListHash(hash)) return false;
+
+  if (f_open(&file, LABELSLIST_INDEX_PATH, FA_OPEN_EXISTING | FA_READ) != FR_OK)
+    return false;
+
+  LabelsIndexHeader header;
+  UINT count;
+  if (f_read(&file, &header, sizeof(header), &count) != FR_OK ||
+      count != sizeof(header) ||
+      memcmp(header.magic, LABELS_INDEX_MAGIC, sizeof(header.magic)) ||
+      header.version != LABELS_INDEX_VERSION ||
+      header.recordSize != sizeof(LabelsIndexRecord) ||
+      memcmp(header.labelsHash, hash, FILE_HASH_LENGTH)) {
+    TRACE_LABELS("labels.idx outdated");
+    f_close(&file);
+    return false;
+  }
+
+  // Read the labels first, nothing is changed until the whole file is checked
+  LabelsVector labels;
+  std::vector<bool> selected;
+  for (unsigned i = 0; i < header.labelsCount; i++) {
+    uint8_t lblHeader[LABELS_INDEX_LABEL_HEADER_SIZE];
+    char lbl[UINT8_MAX];
+    if (f_read(&file, lblHeader, sizeof(lblHeader), &count) != FR_OK ||
+        count != sizeof(lblHeader) ||
+        f_read(&file, lbl, lblHeader[0], &count) != FR_OK ||
+        count != lblHeader[0]) {
+      f_close(&file);
+      return false;
+    }
+    labels.push_back(std::string(lbl, lblHeader[0]));
+    selected.push_back(lblHeader[1] != 0);
+  }
+
+  const unsigned words = (header.labelsCount + 31) / 32;
+  const unsigned recordSize = sizeof(LabelsIndexRecord) + words * sizeof(uint32_t);
+  if (f_size(&file) - f_tell(&file) != (FSIZE_t)header.modelsCount * recordSize) {
+    TRACE_LABELS("labels.idx truncated");
+    f_close(&file);
+    return false;
+  }
+
+  // and the models records as well
+  std::vector<uint8_t> records((size_t)header.modelsCount * recordSize);
+  if (!records.empty() &&
+      (f_read(&file, records.data(), records.size(), &count) != FR_OK ||
+       count != records.size())) {
+    TRACE_LABELS("labels.idx read error");
+    f_close(&file);
+    return false;
+  }
+  f_close(&file);
+
+  for (unsigned i = 0; i < labels.size(); i++) {
+    modelslabels.addLabel(labels[i]);
+    if (selected[i]) modelslabels.addFilteredLabel(labels[i]);
+  }
+  modelslabels.setSortOrder((ModelsSortBy)header.sortOrder);
+
+  std::vector<uint32_t> bits(words);
+  for (unsigned i = 0; i < header.modelsCount; i++) {
+    LabelsIndexRecord record;
+    const uint8_t *data = &records[i * recordSize];
+    memcpy(&record, data, sizeof(record));
+    memcpy(bits.data(), data + sizeof(record), words * sizeof(uint32_t));
+
+    char filename[LEN_MODEL_FILENAME + 1];
+    strAppend(filename, record.filename, LEN_MODEL_FILENAME);
+    filedat *filehash = findFileHash(filename);
+    if (!filehash || filehash->celladded) {
+      TRACE_LABELS("File %s does not exist in /MODELS", filename);
+      continue;
+    }
+
+    ModelCell *model = new ModelCell(filename);
+    strcpy(model->modelFinfoHash, filehash->hash);
+    push_back(model);
+    filehash->celladded = true;
+    if (filehash->curmodel) setCurrentModel(model);
+    model->lastOpened = record.lastOpened;
+
+    if (memcmp(record.hash, filehash->hash, FILE_HASH_LENGTH)) {
+      // model file changed, it will be read again
+      model->_isDirty = true;
+      continue;
+    }
+
+    char name[LEN_MODEL_NAME + 1];
+    strAppend(name, record.name, LEN_MODEL_NAME);
+    model->setModelName(name);
+#if LEN_BITMAP_NAME > 0
+    strAppend(model->modelBitmap, record.bitmap, LEN_BITMAP_NAME);
+#endif
+    for (int j = 0; j < NUM_MODULES; j++) {
+      model->modelId[j] = record.modelId[j];
+      model->moduleData[j] = record.moduleData[j];
+    }
+    model->valid_rfData = true;
+
+    for (unsigned j = 0; j < labels.size(); j++) {
+      if (bits[j / 32] & (1u << (j % 32))) {
+        int ind = modelslabels.getIndexByLabel(labels[j]);
+        if (ind >= 0) model->labels.set(ind);
+      }
+    }
+    model->_isDirty = false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Writes labels.idx, after labels.yml
+ */
+
+void ModelsList::saveIndex(const LabelsVector &order)
+{
+  LabelsIndexHeader header;
+  memcpy(header.magic, LABELS_INDEX_MAGIC, sizeof(header.magic));
+  header.version = LABELS_INDEX_VERSION;
+  header.sortOrder = modelslabels.sortOrder();
+  header.recordSize = sizeof(LabelsIndexRecord);
+  char hash[FILE_HASH_LENGTH + 1];
+  if (!labelsListHash(hash)) return;
+  memcpy(header.labelsHash, hash, FILE_HASH_LENGTH);
+  header.labelsCount = order.size();
+  header.modelsCount = size();
+
+  if (f_open(&file, LABELSLIST_INDEX_PATH, FA_CREATE_ALWAYS | FA_WRITE) != FR_OK)
+    return;
+
+  UINT count;
+  bool ok = f_write(&file, &header, sizeof(header), &count) == FR_OK &&
+            count == sizeof(header);
+
+  for (auto &lbl : order) {
+    if (!ok) break;
+    uint8_t lblHeader[LABELS_INDEX_LABEL_HEADER_SIZE] = {
+        (uint8_t)std::min<size_t>(lbl.size(), UINT8_MAX),
+        modelslabels.isLabelFiltered(lbl)};
+    ok = f_write(&file, lblHeader, sizeof(lblHeader), &count) == FR_OK &&
+         f_write(&file, lbl.c_str(), lblHeader[0], &count) == FR_OK;
+  }
+
+  const unsigned words = (order.size() + 31) / 32;
+  std::vector<uint32_t> bits(words);
+  for (auto &model : *this) {
+    if (!ok) break;
+    LabelsIndexRecord record;
+    memset(&record, 0, sizeof(record));
+    strncpy(record.filename, model->modelFilename, LEN_MODEL_FILENAME);
+    memcpy(record.hash, model->modelFinfoHash, FILE_HASH_LENGTH);
+    strncpy(record.name, model->modelName, LEN_MODEL_NAME);
+#if LEN_BITMAP_NAME > 0
+    strncpy(record.bitmap, model->modelBitmap, LEN_BITMAP_NAME);
+#endif
+    record.lastOpened = model->lastOpened;
+    for (int i = 0; i < NUM_MODULES; i++) {
+      record.modelId[i] = model->modelId[i];
+      record.moduleData[i] = model->moduleData[i];
+    }
+
+    std::fill(bits.begin(), bits.end(), 0);
+    for (const auto &lbl : modelslabels.getLabelsByModel(model)) {
+      auto it = std::find(order.begin(), order.end(), lbl);
+      if (it != order.end()) {
+        unsigned ind = it - order.begin();
+        bits[ind / 32] |= 1u << (ind % 32);
+      }
+    }
+
+    ok = f_write(&file, &record, sizeof(record), &count) == FR_OK &&
+         f_write(&file, bits.data(), words * sizeof(uint32_t), &count) == FR_OK;
+  }
+
+  f_close(&file);
+  if (!ok) f_unlink(LABELSLIST_INDEX_PATH);
+}
+
 /**
  * @brief Loads the Labels and Models from the labels.yml file
  *
@@ -1050,22 +1288,23 @@ bool ModelsList::loadYaml()
     }
     f_closedir(&moddir);
   }
+  std::sort(fileHashInfo.begin(), fileHashInfo.end(),
+            [](const filedat &a, const filedat &b) { return a.name < b.name; });
 
   // Check if models.yml exists
   // Any files found above that are not listed in the file will be moved into
   // /MDOELS/UNUSED and removed from the discovered file hash list
-  char line[LEN_MODELS_IDX_LINE + 1];
   FILINFO fno;
-  FRESULT result;
   bool foundInModels = f_stat(MODELSLIST_YAML_PATH, &fno) == FR_OK;
   bool foundInRadio = f_stat(FALLBACK_MODELSLIST_YAML_PATH, &fno) == FR_OK;
 
-  if(foundInModels) { // Default to /Models copy
-    result = f_open(&file, MODELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  } else if (foundInRadio) {
-    result = f_open(&file, FALLBACK_MODELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  }
-  if((foundInModels || foundInRadio) && result == FR_OK) {
+  // Default to /Models copy
+  std::vector<std::string> modfiles;
+  if ((foundInModels || foundInRadio) &&
+      readYamlFile(foundInModels ? MODELSLIST_YAML_PATH
+                                 : FALLBACK_MODELSLIST_YAML_PATH,
+                   get_modelslist_parser_calls(),
+                   get_modelslist_iter(&modfiles), nullptr) == nullptr) {
     // Create /Models/Unused if it doesn't exist
     bool moveRequired = false;
     DIR unusedFolder;
@@ -1074,23 +1313,10 @@ bool ModelsList::loadYaml()
       if (result == FR_NO_PATH) result = f_mkdir(UNUSED_MODELS_PATH);
       if (result != FR_OK) {
         TRACE("Unable to create unused models folder");
-        f_close(&file);
         return false;
       }
     } else f_closedir(&unusedFolder);
 
-    YamlParser ymp;
-    std::vector<std::string> modfiles;
-    void *ctx = get_modelslist_iter(&modfiles);
-    ymp.init(get_modelslist_parser_calls(), ctx);
-    UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
-      if (bytes_read == 0) break;
-      if (f_eof(&file)) ymp.set_eof();
-      if (ymp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
-    }
-    f_close(&file);
-
     // Loop through file hases, move any files found that don't exists to /unused
     std::vector<filedat> newFileHash;
     for(const auto &fhas: fileHashInfo) {
@@ -1136,19 +1362,10 @@ bool ModelsList::loadYaml()
         debugTimers[debugTimerYamlScan].getLast());
 #endif
 
-  // Scan labels.yml
-  result = f_open(&file, LABELSLIST_YAML_PATH, FA_OPEN_EXISTING | FA_READ);
-  if (result == FR_OK) {
-    YamlParser yp;
-    void *ctx = get_labelslist_iter();
-    yp.init(get_labelslist_parser_calls(), ctx);
-    UINT bytes_read = 0;
-    while (f_read(&file, line, sizeof(line), &bytes_read) == FR_OK) {
-      if (bytes_read == 0) break;
-      if (f_eof(&file)) yp.set_eof();
-      if (yp.parse(line, bytes_read) != YamlParser::CONTINUE_PARSING) break;
-    }
-    f_close(&file);
+  // Scan labels.idx, or labels.yml if it was changed
+  if (!loadIndex()) {
+    readYamlFile(LABELSLIST_YAML_PATH, get_labelslist_parser_calls(),
+                 get_labelslist_iter(), nullptr);
   }
 
 #if defined(DEBUG_TIMERS)
@@ -1326,6 +1543,9 @@ const char *ModelsList::save(LabelsVector newOrder)
 
   f_puts("\r\n", &file);
   f_close(&file);
+#if defined(SDCARD_YAML)
+  saveIndex(newOrder);
+#endif
   modelslabels._isDirty = false;
 
   return NULL;
@@ -1411,7 +1631,7 @@ ModelCell *ModelsList::addModel(const char *fileName, bool save, ModelCell *copy
 {
   ModelCell *result = new ModelCell(fileName);
   if (copyCell != nullptr) { // Duplicate all data
-    memcpy(result, copyCell, sizeof(ModelCell));
+    *result = *copyCell;
   }
 
   // Set the new File Name
@@ -57,6 +57,79 @@
 struct ModelData;
 struct ModuleData;
 
+// Labels are referenced by their index in ModelMap. A model has the mask
+// of its labels indexes: the first 64 labels are kept in place, the
+// following ones in overflow words, allocated only if the model has them.
+class LabelsMask
+{
+ public:
+  bool test(unsigned index) const
+  {
+    if (index < 64) return first & bit(index);
+    unsigned word = index / 64 - 1;
+    return word < overflow.size() && (overflow[word] & bit(index));
+  }
+
+  void set(unsigned index)
+  {
+    if (index < 64) {
+      first |= bit(index);
+      return;
+    }
+    unsigned word = index / 64 - 1;
+    if (word >= overflow.size()) overflow.resize(word + 1, 0);
+    overflow[word] |= bit(index);
+  }
+
+  void reset(unsigned index)
+  {
+    if (index < 64)
+      first &= ~bit(index);
+    else if (index / 64 - 1 < overflow.size())
+      overflow[index / 64 - 1] &= ~bit(index);
+  }
+
+  bool any() const
+  {
+    if (first) return true;
+    for (auto word : overflow)
+      if (word) return true;
+    return false;
+  }
+
+  // has one of the labels of mask
+  bool intersects(const LabelsMask &mask) const
+  {
+    if (first & mask.first) return true;
+    for (unsigned i = 0; i < overflow.size() && i < mask.overflow.size(); i++)
+      if (overflow[i] & mask.overflow[i]) return true;
+    return false;
+  }
+
+  // has all the labels of mask
+  bool contains(const LabelsMask &mask) const
+  {
+    if ((first & mask.first) != mask.first) return false;
+    for (unsigned i = 0; i < mask.overflow.size(); i++) {
+      uint64_t word = i < overflow.size() ? overflow[i] : 0;
+      if ((word & mask.overflow[i]) != mask.overflow[i]) return false;
+    }
+    return true;
+  }
+
+  void clear()
+  {
+    first = 0;
+    overflow.clear();
+  }
+
+ protected:
+  static uint64_t bit(unsigned index) { return (uint64_t)1 << (index % 64); }
+
+  uint64_t first = 0;
+  std::vector<uint64_t> overflow;
+};
+
 struct SimpleModuleData {
   uint8_t type = 0;
   uint8_t subType = 0;
@@ -80,6 +153,7 @@ class ModelCell
   char modelBitmap[LEN_BITMAP_NAME + 1] = "";
 #endif
   gtime_t lastOpened = 0;
+  LabelsMask labels;
   bool _isDirty = true;
 
   bool valid_rfData;
@@ -116,11 +190,11 @@ typedef enum {
 } ModelsSortBy;
 
 /**
- * @brief ModelMap is a multimap of all models and their cooresponding
- *        labels. Lables are referenced by index, stored in var labels
+ * @brief ModelMap holds the labels of all models. Labels are referenced by
+ *        index, stored in var labels, each model has a mask of its labels
  */
 
-class ModelMap : protected std::multimap<uint16_t, ModelCell *>
+class ModelMap
 {
  public:
   ModelsVector getUnlabeledModels();
@@ -173,6 +247,8 @@ class ModelMap : protected std::multimap<uint16_t, ModelCell *>
                           const std::string &from,
                           const std::string &to);
 
+  void clear();
+
  protected:
   ModelsSortBy _sortOrder = DEFAULT_MODEL_SORT;
   bool _isDirty = true;
@@ -185,13 +261,6 @@ class ModelMap : protected std::multimap<uint16_t, ModelCell *>
   bool updateModelFile(ModelCell *);
   void sortModelsBy(ModelsVector &mv, ModelsSortBy sortby);
 
-  void clear()
-  {
-    _isDirty = true;
-    labels.clear();
-    std::multimap<uint16_t, ModelCell *>::clear();
-  }
-
   int getIndexByLabel(const std::string &str)
   {
     auto a = std::find(labels.begin(), labels.end(), str);
@@ -265,6 +334,7 @@ class ModelsList : public ModelsVector
     bool celladded = false;
   } filedat;
   std::vector<filedat> fileHashInfo;
+  filedat *findFileHash(const char *name);
 
  protected:
   FIL file;
@@ -273,6 +343,8 @@ class ModelsList : public ModelsVector
 #if defined(SDCARD_YAML)
   bool loadYaml();
   bool loadYamlDirScanner();
+  bool loadIndex();
+  void saveIndex(const LabelsVector &order);
 #endif
 };
 
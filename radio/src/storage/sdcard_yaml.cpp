@@ -40,6 +40,38 @@
  #include "storage/eeprom_rlc.h"
 #endif
 
+// Whole sectors are read at once, so that FatFS copies them straight
+// from the card instead of going through the file sector buffer.
+// Only used from the menus task: not reentrant.
+static uint8_t _yaml_read_buffer[YAML_READ_BUFFER_SIZE] __DMA;
+
+// Returns the length of the "checksum: N" line (including the newline),
+// 0 if there is none, or -1 if the line is not complete.
+static int parseChecksumLine(const char * buffer, UINT len, uint16_t * checksum)
+{
+  static const char prefix[] = "checksum: ";
+  const UINT prefix_len = sizeof(prefix) - 1;
+
+  if (len < prefix_len || strncmp(buffer, prefix, prefix_len) != 0)
+    return 0;
+
+  UINT pos = prefix_len;
+  uint32_t value = 0;
+  while (pos < len && buffer[pos] >= '0' && buffer[pos] <= '9') {
+    value = value * 10 + (buffer[pos++] - '0');
+  }
+
+  // Skip anything else up to the end of the line
+  while (pos < len && buffer[pos] != '\r' && buffer[pos] != '\n') pos++;
+  if (pos == len) return -1;
+
+  // Skip trailing newline
+  while (pos < len && (buffer[pos] == '\r' || buffer[pos] == '\n')) pos++;
+
+  *checksum = (uint16_t)value;
+  return pos;
+}
+
 const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, void* parser_ctx, ChecksumResult* checksum_result)
 {
     FIL  file;
@@ -57,40 +89,23 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
     uint16_t calculated_checksum = 0xFFFF;
     uint16_t file_checksum = 0;
 
-    bool first_block = true;
-    char buffer[32];
-    while (f_read(&file, buffer, sizeof(buffer)-1, &bytes_read) == FR_OK) {
+    char * buffer = (char *)_yaml_read_buffer;
+    while ((result = f_read(&file, buffer, YAML_READ_BUFFER_SIZE, &bytes_read)) == FR_OK) {
       if (bytes_read == 0)  // EOF
         break;
-      total_bytes += bytes_read;
 
-      uint16_t skip = 0;
-      if(first_block) {
+      UINT skip = 0;
+      if (total_bytes == 0) {
         // Get the 'checksum' value and skip from further YAML processing
-        // The checksum must be first in the first buffer read from file
-        first_block = false;
-        const char *skipValue = "checksum: ";
-        if(strncmp(buffer, skipValue, strlen(skipValue)) == 0) {
-          skip = 10;
-          char* startPos = buffer + strlen(skipValue);
-          char* endPos = startPos;
-          // Advance through the value
-          while((*endPos != '\r') && (*endPos != '\n')) {
-            if (endPos > buffer + bytes_read) {
-              return SDCARD_ERROR(	FR_INT_ERR );
-            }
-            endPos++;
-          }
-          // Skip trailing newline
-          while((*endPos == '\r') || (*endPos == '\n')) {
-            *endPos = 0;
-            endPos++;
-          }
-
-          file_checksum = atoi(startPos);
-          skip = endPos - buffer;
+        // The checksum must be the first line of the file
+        int len = parseChecksumLine(buffer, bytes_read, &file_checksum);
+        if (len < 0) {
+          result = FR_INT_ERR;
+          break;
         }
+        skip = len;
       }
+      total_bytes += bytes_read;
 
       // Calculate checksum on read block only if we are called with a pointer to write the resulting checksum
       if (checksum_result != NULL) {
@@ -103,6 +118,10 @@ const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls, vo
     }
     f_close(&file);
 
+    if (result != FR_OK) {
+      return SDCARD_ERROR(result);
+    }
+
     if (checksum_result != NULL) {
       // Special case to handle "old" files with no checksum field
       // 25 was arbitrarily chosen as the minimum realistic file size
@@ -26,6 +26,20 @@ enum class ChecksumResult {Success, Failed, None};
 
 constexpr uint8_t MODELIDX_STRLEN = sizeof(MODEL_FILENAME_PREFIX "00");
 
+// YAML files are read by blocks of whole sectors
+#if defined(COLORLCD)
+  #define YAML_READ_BUFFER_SIZE  4096
+#else
+  #define YAML_READ_BUFFER_SIZE  512
+#endif
+
+struct YamlParserCalls;
+
+// Parses the file in one pass, checking the checksum if 'checksum_result'
+// is not NULL (menus task only)
+const char * readYamlFile(const char* fullpath, const YamlParserCalls* calls,
+                          void* parser_ctx, ChecksumResult* checksum_result);
+
 const char * loadRadioSettingsYaml(bool checks);
 const char * writeModelYaml(const char* filename);
 const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t size, const char* pathName = STR_MODELS_PATH);
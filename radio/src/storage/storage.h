@@ -55,12 +55,20 @@ void storageCheck(bool immediately);
 // Generic storage functions (implemented in storage_common.cpp)
 //
 void storageDirty(uint8_t msk);
+void modelCachesInvalidate();
+void checkModelCaches();
 void storageFlushCurrentModel();
 void postRadioSettingsLoad();
 void preModelLoad();
 void postModelLoad(bool alarms);
 void checkExternalAntenna();
 
+#if defined(SIMU)
+// Forces the caches built from the model data to be rebuilt before
+// each use (benchmarks only: the tests call storageDirty() as the menus do)
+extern bool modelCachesAlwaysRebuild;
+#endif
+
 #if !defined(STORAGE_MODELSLIST)
 extern ModelHeader modelHeaders[MAX_MODELS];
 
@@ -23,6 +23,8 @@
 #include "timers_driver.h"
 #include "tasks/mixer_task.h"
 #include "mixes.h"
+#include "mixer_plan.h"
+#include "lsw_plan.h"
 
 #if defined(USBJ_EX)
 #include "usb_joystick.h"
@@ -38,22 +40,57 @@
 uint8_t   storageDirtyMsk;
 tmr10ms_t storageDirtyTime10ms;
 
+#if defined(SIMU)
+bool modelCachesAlwaysRebuild = false;
+#endif
+
 #if defined(RTC_BACKUP_RAM)
 uint8_t   rambackupDirtyMsk = EE_GENERAL | EE_MODEL;
 tmr10ms_t rambackupDirtyTime10ms;
 #endif
 
+static volatile bool modelCachesCheckPending = false;
+
+void modelCachesInvalidate()
+{
+  mixerPlanInvalidate();
+  lswPlanInvalidate();
+  curvesCacheInvalidate();
+#if defined(GVARS)
+  gvarsCacheInvalidate();
+#endif
+  telemetrySensorsIndexInvalidate();
+  luaFieldsCacheInvalidate();
+}
+
 void storageDirty(uint8_t msk)
 {
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  if (msk & EE_MODEL) {
+    modelCachesInvalidate();
+    modelCachesCheckPending = true;
+  }
+
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
 #endif
 }
 
+// The menus call storageDirty() before writing the edited value
+// (checkIncDec() returns it to the caller): the mixer may rebuild its
+// caches from the old value in between. They are invalidated again
+// from the menus loop, once the edit is done.
+void checkModelCaches()
+{
+  if (modelCachesCheckPending) {
+    modelCachesCheckPending = false;
+    modelCachesInvalidate();
+  }
+}
+
 void preModelLoad()
 {
   watchdogSuspend(500/*5s*/);
@@ -144,6 +181,7 @@ static void sanitizeMixerLines()
 {
   bool dirty = sortMixerLines();
   updateMixCount();
+  mixerPlanInvalidate();
   if (dirty) storageDirty(EE_MODEL);
 }
 
@@ -234,6 +272,7 @@ if(g_model.rssiSource) {
       telemetryItems[i].timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
     }
   }
+  modelCachesInvalidate();
 
   loadCurves();
   sanitizeMixerLines();
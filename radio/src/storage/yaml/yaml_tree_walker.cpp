@@ -249,6 +249,14 @@ void YamlTreeWalker::rewind()
     }
 }
 
+static inline bool yaml_tag_match(const YamlNode* attr, const char* tag,
+                                  uint8_t tag_len)
+{
+    // avoids strlen() on each attribute tag
+    return attr->tag && !strncmp(tag, attr->tag, tag_len)
+        && attr->tag[tag_len] == '\0';
+}
+
 // Increment the cursor until a match is found or the end of
 // the current collection (node of type YDT_NONE) is reached.
 //
@@ -258,6 +266,12 @@ bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
     if (virt_level)
         return false;
 
+    // Files are written in the order of the nodes, so the tag looked
+    // for usually follows the current attribute: start from there, and
+    // only go through the whole collection if it is not found.
+    if (!isArrayElmt() && findNextNode(tag, tag_len))
+        return true;
+
     rewind();
 
     const struct YamlNode* attr = getAttr();
@@ -266,10 +280,16 @@ bool YamlTreeWalker::findNode(const char* tag, uint8_t tag_len)
         return true;
     }
 
+    return findNextNode(tag, tag_len);
+}
+
+// Walk from the current attribute up to the end of the collection
+bool YamlTreeWalker::findNextNode(const char* tag, uint8_t tag_len)
+{
+    const struct YamlNode* attr = getAttr();
     while(attr && attr->type != YDT_NONE) {
 
-        if ((tag_len == attr->tag_len())
-            && !strncmp(tag, attr->tag, tag_len)) {
+        if (yaml_tag_match(attr, tag, tag_len)) {
             return true; // attribute found!
         }
 
@@ -428,7 +448,7 @@ void YamlTreeWalker::toNextAttr()
 
     // anonymous union handling
     attr = getAttr();
-    if ((attr->type == YDT_UNION) && (strlen(attr->tag) == 0)) {
+    if ((attr->type == YDT_UNION) && (attr->tag[0] == '\0')) {
         toChild();
         anon_union++;
     }
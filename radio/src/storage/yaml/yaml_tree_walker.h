@@ -111,6 +111,10 @@ class YamlTreeWalker
     // (and reset the bit offset)
     void rewind();
 
+    // Same as findNode(), but starts from the current attribute
+    // instead of rewinding first
+    bool findNextNode(const char* tag, uint8_t tag_len);
+
 public:
     YamlTreeWalker();
 
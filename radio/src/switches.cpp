@@ -25,6 +25,7 @@
 #include "opentx.h"
 #include "switches.h"
 #include "input_mapping.h"
+#include "lsw_plan.h"
 
 #include "tasks/mixer_task.h"
 
@@ -365,18 +366,33 @@ uint8_t switchGetMaxRow(uint8_t col)
   return lastrow;
 }
 
+static getvalue_t addInputTrim(getvalue_t result, uint8_t input)
+{
+  int8_t trimIdx = virtualInputsTrims[input];
+  if (trimIdx >= 0) {
+    int16_t trim = trims[trimIdx];
+    if (trimIdx == inputMappingConvertMode(inputMappingGetThrottle()) && g_model.throttleReversed)
+      result -= trim;
+    else
+      result += trim;
+  }
+  return result;
+}
+
 getvalue_t getValueForLogicalSwitch(mixsrc_t i)
 {
   getvalue_t result = getValue(i);
   if (i>=MIXSRC_FIRST_INPUT && i<=MIXSRC_LAST_INPUT) {
-    int8_t trimIdx = virtualInputsTrims[i-MIXSRC_FIRST_INPUT];
-    if (trimIdx >= 0) {
-      int16_t trim = trims[trimIdx];
-      if (trimIdx == inputMappingConvertMode(inputMappingGetThrottle()) && g_model.throttleReversed)
-        result -= trim;
-      else
-        result += trim;
-    }
+    result = addInputTrim(result, i-MIXSRC_FIRST_INPUT);
+  }
+  return result;
+}
+
+static getvalue_t getValueForLogicalSwitch(MixSourceRef src)
+{
+  getvalue_t result = getValue(src);
+  if (src.category == MIXSRC_CAT_INPUT) {
+    result = addInputTrim(result, src.index);
   }
   return result;
 }
@@ -391,8 +407,9 @@ PACK(typedef struct {
   uint16_t duration:15;
 }) ls_stay_struct;
 
-bool getLogicalSwitch(uint8_t idx)
+static bool getLogicalSwitch(const LswPlanEntry& entry)
 {
+  uint8_t idx = entry.idx;
   LogicalSwitchData * ls = lswAddress(idx);
   bool result;
 
@@ -431,10 +448,10 @@ bool getLogicalSwitch(uint8_t idx)
     result = (LS_LAST_VALUE(mixerCurrentFlightMode, idx) & (1<<0));
   }
   else {
-    getvalue_t x = getValueForLogicalSwitch(ls->v1);
+    getvalue_t x = getValueForLogicalSwitch(entry.v1);
     getvalue_t y;
     if (s == LS_FAMILY_COMP) {
-      y = getValueForLogicalSwitch(ls->v2);
+      y = getValueForLogicalSwitch(entry.v2);
 
       switch (ls->func) {
         case LS_FUNC_EQUAL:
@@ -660,9 +677,12 @@ uint8_t getXPotPosition(uint8_t idx)
 */
 void evalLogicalSwitches(bool isCurrentFlightmode)
 {
-  for (unsigned int idx=0; idx<MAX_LOGICAL_SWITCHES; idx++) {
+  const LswPlan& plan = lswPlanGet();
+  for (uint8_t i=0; i<plan.count; i++) {
+    const LswPlanEntry& entry = plan.entries[i];
+    uint8_t idx = entry.idx;
     LogicalSwitchContext & context = lswFm[mixerCurrentFlightMode].lsw[idx];
-    bool result = getLogicalSwitch(idx);
+    bool result = getLogicalSwitch(entry);
     if (isCurrentFlightmode) {
       if (result) {
         if (!context.state) PLAY_LOGICAL_SWITCH_ON(idx);
@@ -946,9 +966,14 @@ void logicalSwitchesTimerTick()
     msg = luaSetStickySwitchBuffer.read();
   }
 
-  // Update logical switches
+  // Update logical switches (only those with a state or a timer to update)
+  const LswPlan& plan = lswPlanGet();
   for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
-    for (uint8_t i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+    for (uint8_t n=0; n<plan.count; n++) {
+      const LswPlanEntry& entry = plan.entries[n];
+      if (!(entry.flags & (LSW_PLAN_TIMED | LSW_PLAN_DELAYED)))
+        continue;
+      uint8_t i = entry.idx;
       LogicalSwitchData * ls = lswAddress(i);
       if (ls->func == LS_FUNC_TIMER) {
         int16_t * lastValue = &LS_LAST_VALUE(fm, i);
@@ -1066,6 +1091,35 @@ void logicalSwitchesReset()
   luaSetStickySwitchBuffer.clear();
 }
 
+void logicalSwitchesResetUnused(const LswPlan& plan)
+{
+  uint64_t used = 0;
+  uint64_t delayed = 0;
+  for (uint8_t n=0; n<plan.count; n++) {
+    const LswPlanEntry& entry = plan.entries[n];
+    used |= (uint64_t)1 << entry.idx;
+    if (entry.flags & LSW_PLAN_DELAYED)
+      delayed |= (uint64_t)1 << entry.idx;
+  }
+
+  // the logical switches not evaluated anymore are off, and the timers
+  // not updated anymore are stopped (same as evaluating them)
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t i=0; i<MAX_LOGICAL_SWITCHES; i++) {
+      LogicalSwitchContext &context = lswFm[fm].lsw[i];
+      uint64_t mask = (uint64_t)1 << i;
+      if (!(used & mask)) {
+        context.state = 0;
+        LS_LAST_VALUE(fm, i) = CS_LAST_VALUE_INIT;
+      }
+      if (!(delayed & mask)) {
+        context.timerState = SWITCH_START;
+        context.timer = 0;
+      }
+    }
+  }
+}
+
 getvalue_t convertLswTelemValue(LogicalSwitchData * ls)
 {
   getvalue_t val;
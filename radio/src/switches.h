@@ -46,6 +46,10 @@ void logicalSwitchesCopyState(uint8_t src, uint8_t dst);
 void logicalSwitchesReset();
 void logicalSwitchesTimerTick();
 
+// resets the contexts not used by the new logical switches plan
+struct LswPlan;
+void logicalSwitchesResetUnused(const LswPlan& plan);
+
 bool isSwitchWarningRequired(uint16_t &bad_pots);
 
 void getSwitchesPosition(bool startup);
@@ -494,6 +494,48 @@ static int stm32_serial_copy_rx_buffer(void* ctx, uint8_t* buf, uint32_t len)
   return res;
 }
 
+static int stm32_serial_get_buffer(void* ctx, const uint8_t** data)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return -1;
+
+  auto sp = st->sp;
+  const auto& rx_buf = sp->rx_buffer;
+  auto buf_len = rx_buf.length;
+  if (!buf_len) return -1;
+
+  uint32_t widx;
+  auto usart = sp->usart;
+  const auto& buf_st = st->rx_buf;
+
+  if (LL_USART_IsEnabledDMAReq_RX(usart->USARTx)) {
+    auto dma = usart->rxDMA;
+    auto stream = usart->rxDMA_Stream;
+    widx = buf_len - LL_DMA_GetDataLength(dma, stream);
+  } else {
+    widx = buf_st.widx;
+  }
+
+  uint32_t ridx = buf_st.ridx;
+  if (ridx == widx) return 0;
+
+  // up to the write index, or to the end of the buffer
+  *data = rx_buf.buffer + ridx;
+  return ridx < widx ? widx - ridx : buf_len - ridx;
+}
+
+static void stm32_serial_consume_buffer(void* ctx, uint32_t len)
+{
+  auto st = (stm32_serial_state*)ctx;
+  if (!st) return;
+
+  auto buf_len = st->sp->rx_buffer.length;
+  if (!buf_len) return;
+
+  auto& buf_st = st->rx_buf;
+  buf_st.ridx = (buf_st.ridx + len) & (buf_len - 1);
+}
+
 static void stm32_serial_clear_rx_buffer(void* ctx)
 {
   auto st = (stm32_serial_state*)ctx;
@@ -566,6 +608,8 @@ const etx_serial_driver_t STM32SerialDriver = {
   .getLastByte = stm32_serial_get_last_byte,
   .getBufferedBytes = stm32_serial_get_buffered_bytes,
   .copyRxBuffer = stm32_serial_copy_rx_buffer,
+  .getBuffer = stm32_serial_get_buffer,
+  .consumeBuffer = stm32_serial_consume_buffer,
   .clearRxBuffer = stm32_serial_clear_rx_buffer,
   .getBaudrate = stm32_serial_get_baudrate,
   .setBaudrate = stm32_serial_set_baudrate,
@@ -186,6 +186,21 @@ static int stm32_softserial_rx_get_byte(void* ctx, uint8_t* data)
   return 1;
 }
 
+static int stm32_softserial_rx_get_buffer(void* ctx, const uint8_t** data)
+{
+  uint8_t ridx = rxRidx;
+  uint8_t widx = rxWidx;
+  if (widx == ridx) return 0;
+
+  *data = rxBuffer + ridx;
+  return ridx < widx ? widx - ridx : rxBufLen - ridx;
+}
+
+static void stm32_softserial_rx_consume_buffer(void* ctx, uint32_t len)
+{
+  rxRidx = (rxRidx + len) & (rxBufLen - 1);
+}
+
 void stm32_softserial_rx_timer_isr(const stm32_softserial_rx_port* port)
 {
   auto TIMx = port->TIMx;
@@ -233,6 +248,8 @@ const etx_serial_driver_t STM32SoftSerialRxDriver = {
   .enableRx = nullptr,
   .getByte = stm32_softserial_rx_get_byte,
   .getLastByte = nullptr,
+  .getBuffer = stm32_softserial_rx_get_buffer,
+  .consumeBuffer = stm32_softserial_rx_consume_buffer,
   .clearRxBuffer = stm32_softserial_rx_clear_rx_buffer,
   .getBaudrate = nullptr,
   .setReceiveCb = nullptr,
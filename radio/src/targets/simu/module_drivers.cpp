@@ -104,6 +104,8 @@ const etx_serial_driver_t _fakeSerialDriver = {
     .getLastByte = nullptr,
     .getBufferedBytes = nullptr,
     .copyRxBuffer = nullptr,
+    .getBuffer = nullptr,
+    .consumeBuffer = nullptr,
     .clearRxBuffer = nullptr,
     .getBaudrate = nullptr,
     .setBaudrate = nullptr,
@@ -35,6 +35,7 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <string>
+#include <vector>
 
 #if !defined (_MSC_VER) || defined (__GNUC__)
   #include <chrono>
@@ -67,8 +68,168 @@ extern const etx_hal_adc_driver_t simu_adc_driver;
 
 void lcdCopy(void * dest, void * src);
 
+// Virtual time (simuSetVirtualTime()): the time only advances with
+// simuAdvanceTime(), which runs the 10ms interrupt and resumes the tasks
+// waiting in simuSleep() one at a time, in deadline order. A run then only
+// depends on its inputs, and goes as fast as the CPU allows.
+//
+// The tasks must not wait in simuSleep() while holding a mutex
+// needed by another task.
+struct SimuSleepingTask {
+  uint64_t deadline;
+  uint32_t seq;
+};
+
+static bool simu_virtual_time = false;
+static volatile uint64_t simu_virtual_us = 0;
+static uint64_t simu_virtual_next_tick = 0;
+static pthread_mutex_t simu_virtual_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t simu_virtual_cond = PTHREAD_COND_INITIALIZER;
+static std::vector<SimuSleepingTask> simu_sleeping_tasks;
+static int simu_running_tasks = 0;     // tasks not waiting in simuSleep()
+static uint32_t simu_sleep_seq = 0;
+static uint32_t simu_resumed_seq = 0;  // task allowed to run
+static thread_local bool simu_is_task = false;
+
+void simuSetVirtualTime(bool enabled)
+{
+  assert(!simu_running);
+  simu_virtual_time = enabled;
+  simu_virtual_us = 0;
+  simu_virtual_next_tick = 0;
+}
+
+bool simuIsVirtualTime()
+{
+  return simu_virtual_time;
+}
+
+static uint8_t simuVirtualSleep(uint32_t ms)
+{
+  pthread_mutex_lock(&simu_virtual_mutex);
+
+  uint32_t seq = ++simu_sleep_seq;
+  simu_sleeping_tasks.push_back({simu_virtual_us + ms * 1000ULL, seq});
+  simu_running_tasks--;
+  pthread_cond_broadcast(&simu_virtual_cond);
+
+  while (simu_resumed_seq != seq && !simu_shutdown) {
+    pthread_cond_wait(&simu_virtual_cond, &simu_virtual_mutex);
+  }
+
+  if (simu_resumed_seq != seq) {
+    // shutdown: not resumed by simuAdvanceTime()
+    for (auto it = simu_sleeping_tasks.begin(); it != simu_sleeping_tasks.end(); ++it) {
+      if (it->seq == seq) {
+        simu_sleeping_tasks.erase(it);
+        break;
+      }
+    }
+    simu_running_tasks++;
+  }
+
+  pthread_mutex_unlock(&simu_virtual_mutex);
+  return simu_shutdown ? 1 : 0;
+}
+
+// Called with the mutex held
+static void simuWaitTasksSleeping()
+{
+  while (simu_running_tasks > 0 && !simu_shutdown) {
+    pthread_cond_wait(&simu_virtual_cond, &simu_virtual_mutex);
+  }
+}
+
+void simuAdvanceTime(uint32_t ms)
+{
+  assert(simu_virtual_time);
+
+  pthread_mutex_lock(&simu_virtual_mutex);
+  simuWaitTasksSleeping();
+
+  uint64_t target = simu_virtual_us + ms * 1000ULL;
+  while (!simu_shutdown) {
+    auto next = simu_sleeping_tasks.end();
+    for (auto it = simu_sleeping_tasks.begin(); it != simu_sleeping_tasks.end(); ++it) {
+      if (next == simu_sleeping_tasks.end() || it->deadline < next->deadline ||
+          (it->deadline == next->deadline && it->seq < next->seq))
+        next = it;
+    }
+
+    // the 10ms interrupt goes before the tasks
+    if (simu_virtual_next_tick <= target &&
+        (next == simu_sleeping_tasks.end() || simu_virtual_next_tick <= next->deadline)) {
+      simu_virtual_us = simu_virtual_next_tick;
+      simu_virtual_next_tick += 10000;
+      pthread_mutex_unlock(&simu_virtual_mutex);
+      per10ms();
+      pthread_mutex_lock(&simu_virtual_mutex);
+      continue;
+    }
+
+    if (next == simu_sleeping_tasks.end() || next->deadline > target)
+      break;
+
+    if (next->deadline > simu_virtual_us)
+      simu_virtual_us = next->deadline;
+    simu_resumed_seq = next->seq;
+    simu_sleeping_tasks.erase(next);
+    simu_running_tasks++;
+    pthread_cond_broadcast(&simu_virtual_cond);
+    simuWaitTasksSleeping();
+  }
+
+  simu_virtual_us = target;
+  pthread_mutex_unlock(&simu_virtual_mutex);
+}
+
+struct SimuTask {
+  void * (*task)(void *);
+};
+
+static void * simuTaskEntry(void * arg)
+{
+  auto task = (SimuTask *)arg;
+  auto run = task->task;
+  delete task;
+
+  simu_is_task = true;
+  if (simu_virtual_time) {
+    // start when resumed by simuAdvanceTime()
+    simuVirtualSleep(0);
+  }
+
+  void * result = run(nullptr);
+
+  if (simu_virtual_time) {
+    pthread_mutex_lock(&simu_virtual_mutex);
+    simu_running_tasks--;
+    pthread_cond_broadcast(&simu_virtual_cond);
+    pthread_mutex_unlock(&simu_virtual_mutex);
+  }
+
+  return result;
+}
+
+void simuCreateTask(pthread_t &taskId, void * (*task)(void *), const char * name)
+{
+  if (simu_virtual_time) {
+    pthread_mutex_lock(&simu_virtual_mutex);
+    simu_running_tasks++;
+    pthread_mutex_unlock(&simu_virtual_mutex);
+  }
+
+  pthread_create(&taskId, nullptr, simuTaskEntry, new SimuTask{task});
+#ifdef __linux__
+  pthread_setname_np(taskId, name);
+#endif
+}
+
 uint64_t simuTimerMicros(void)
 {
+  if (simu_virtual_time)
+    return simu_virtual_us;
+
 #if SIMPGMSPC_USE_QT
   static QElapsedTimer ticker;
   if (!ticker.isValid())
@@ -184,9 +345,12 @@ void simuStart(bool tests, const char * sdPath, const char * settingsPath)
   time_t rawtime;
   struct tm * timeinfo;
   time (&rawtime);
-  timeinfo = localtime (&rawtime);
+  // virtual time: the same date for each run
+  timeinfo = simu_virtual_time ? nullptr : localtime (&rawtime);
 
-  if (timeinfo != nullptr) {
+  if (simu_virtual_time) {
+    g_rtcTime = 0;
+  } else if (timeinfo != nullptr) {
     struct gtm gti;
     gti.tm_sec  = timeinfo->tm_sec;
     gti.tm_min  = timeinfo->tm_min;
@@ -243,6 +407,13 @@ void simuStop()
 
   simu_shutdown = true;
 
+  if (simu_virtual_time) {
+    // wake up the tasks waiting for the virtual time
+    pthread_mutex_lock(&simu_virtual_mutex);
+    pthread_cond_broadcast(&simu_virtual_cond);
+    pthread_mutex_unlock(&simu_virtual_mutex);
+  }
+
   pthread_join(mixerTaskId, nullptr);
   pthread_join(menusTaskId, nullptr);
 
@@ -265,6 +436,11 @@ bool simuIsRunning()
 
 uint8_t simuSleep(uint32_t ms)
 {
+  if (simu_virtual_time) {
+    // only the tasks wait for the virtual time
+    return simu_is_task ? simuVirtualSleep(ms) : (simu_shutdown ? 1 : 0);
+  }
+
   for (uint32_t i = 0; i < ms; ++i){
     if (simu_shutdown || !simu_running)
       return 1;
@@ -616,6 +792,8 @@ static const etx_serial_driver_t _fake_drv = {
   .getLastByte = nullptr,
   .getBufferedBytes = nullptr,
   .copyRxBuffer = nullptr,
+  .getBuffer = nullptr,
+  .consumeBuffer = nullptr,
   .clearRxBuffer = nullptr,
   .getBaudrate = nullptr,
   .setBaudrate = nullptr,
@@ -54,6 +54,12 @@ void simuInit();
 void simuStart(bool tests = true, const char * sdPath = nullptr, const char * settingsPath = nullptr);
 void simuStop();
 bool simuIsRunning();
+
+// Virtual time: to be enabled before simuStart(). The time is then only
+// advanced by simuAdvanceTime(), which also runs per10ms()
+void simuSetVirtualTime(bool enabled);
+bool simuIsVirtualTime();
+void simuAdvanceTime(uint32_t ms);
 void startEepromThread(const char * filename = "eeprom.bin");
 void stopEepromThread();
 
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+// Headless simulator in virtual time, for batch model validation.
+//
+// Usage: simu-runner [-sd <path>] [-settings <path>] <script|->
+//
+// The script gives the inputs and the time steps, one command per line
+// ('#' starts a comment):
+//   ana <index> <value>                 analog input (-1024..1024)
+//   switch <index> <-1|0|1>             switch position
+//   key <index> <0|1>                   key state
+//   trim <index> <0|1>                  trim switch state
+//   telemetry <hex bytes>               S.PORT packet (internal module)
+//   wait <ms>                           advance the virtual time
+//   print [channels]                    output "<time ms>,<ch1>,<ch2>..."
+//   sweep <ana> <from> <to> <step> <ms> ana + wait + print for each value
+//
+// The results only depend on the model and the script.
+
+#include "opentx.h"
+#include "hal/adc_driver.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int16_t simuAnalogs[MAX_ANALOG_INPUTS];
+
+uint16_t simu_get_analog(uint8_t idx)
+{
+  return (simuAnalogs[idx] * 2) + 2048;
+}
+
+static void printChannels(int count)
+{
+  if (count <= 0 || count > MAX_OUTPUT_CHANNELS)
+    count = MAX_OUTPUT_CHANNELS;
+
+  printf("%u", (unsigned)(simuTimerMicros() / 1000));
+  for (int i = 0; i < count; i++) {
+    printf(",%d", channelOutputs[i]);
+  }
+  printf("\n");
+}
+
+static bool setAnalog(int index, int value)
+{
+  if (index < 0 || index >= MAX_ANALOG_INPUTS)
+    return false;
+  simuAnalogs[index] = limit<int>(-1024, value, 1024);
+  return true;
+}
+
+static bool sendTelemetry(const char * hex)
+{
+  uint8_t packet[32];
+  uint8_t len = 0;
+
+  while (*hex) {
+    if (*hex == ' ') {
+      hex++;
+      continue;
+    }
+    char * end;
+    char byte[3] = { hex[0], hex[1], '\0' };
+    if (len >= sizeof(packet) || !hex[1])
+      return false;
+    packet[len++] = strtoul(byte, &end, 16);
+    if (*end)
+      return false;
+    hex += 2;
+  }
+
+  sportProcessTelemetryPacket(INTERNAL_MODULE, packet, len);
+  return true;
+}
+
+static bool runCommand(char * line)
+{
+  char * comment = strchr(line, '#');
+  if (comment)
+    *comment = '\0';
+
+  char cmd[16];
+  int n = 0;
+  if (sscanf(line, "%15s %n", cmd, &n) < 1)
+    return true;  // empty line
+  const char * args = line + n;
+
+  int a, b, c, d, e;
+  int count = sscanf(args, "%d %d %d %d %d", &a, &b, &c, &d, &e);
+
+  if (!strcmp(cmd, "ana") && count == 2) {
+    return setAnalog(a, b);
+  }
+  else if (!strcmp(cmd, "switch") && count == 2) {
+    simuSetSwitch(a, b);
+  }
+  else if (!strcmp(cmd, "key") && count == 2 && a >= 0 && a < MAX_KEYS) {
+    simuSetKey(a, b);
+  }
+  else if (!strcmp(cmd, "trim") && count == 2 && a >= 0 && a < MAX_TRIMS * 2) {
+    simuSetTrim(a, b);
+  }
+  else if (!strcmp(cmd, "telemetry")) {
+    return sendTelemetry(args);
+  }
+  else if (!strcmp(cmd, "wait") && count == 1 && a >= 0) {
+    simuAdvanceTime(a);
+  }
+  else if (!strcmp(cmd, "print")) {
+    printChannels(count == 1 ? a : 0);
+  }
+  else if (!strcmp(cmd, "sweep") && count == 5 && d != 0 && e >= 0) {
+    for (int value = b; d > 0 ? value <= c : value >= c; value += d) {
+      if (!setAnalog(a, value))
+        return false;
+      simuAdvanceTime(e);
+      printChannels(0);
+    }
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+int main(int argc, char ** argv)
+{
+  const char * sdPath = nullptr;
+  const char * settingsPath = nullptr;
+  const char * scriptPath = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-sd") && i + 1 < argc)
+      sdPath = argv[++i];
+    else if (!strcmp(argv[i], "-settings") && i + 1 < argc)
+      settingsPath = argv[++i];
+    else
+      scriptPath = argv[i];
+  }
+
+  if (!scriptPath) {
+    fprintf(stderr, "Usage: %s [-sd <path>] [-settings <path>] <script|->\n", argv[0]);
+    return 1;
+  }
+
+  FILE * script = strcmp(scriptPath, "-") ? fopen(scriptPath, "r") : stdin;
+  if (!script) {
+    fprintf(stderr, "Cannot open %s\n", scriptPath);
+    return 1;
+  }
+
+  simuInit();
+  simuSetVirtualTime(true);
+  simuStart(false, sdPath, settingsPath);
+
+  int result = 0;
+  char line[256];
+  for (int lineNumber = 1; fgets(line, sizeof(line), script); lineNumber++) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if (!runCommand(line)) {
+      fprintf(stderr, "%s:%d: invalid command '%s'\n", scriptPath, lineNumber, line);
+      result = 1;
+      break;
+    }
+  }
+
+  if (script != stdin)
+    fclose(script);
+
+  simuStop();
+  return result;
+}
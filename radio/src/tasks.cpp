@@ -27,6 +27,10 @@
 #include "tasks.h"
 #include "tasks/mixer_task.h"
 
+#if defined(SDCARD)
+  #include "file_sink.h"
+#endif
+
 
 RTOS_TASK_HANDLE menusTaskId;
 RTOS_DEFINE_STACK(menusTaskId, menusStack, MENUS_STACK_SIZE);
@@ -113,5 +117,9 @@ void tasksStart()
                    AUDIO_STACK_SIZE, AUDIO_TASK_PRIO);
 #endif
 
+#if defined(SDCARD)
+  fileSinksInit();
+#endif
+
   RTOS_START();
 }
@@ -40,17 +40,20 @@
 #endif
 
 #define CLI_STACK_SIZE         1024  // only consumed with CLI build option
+#define FILE_SINKS_STACK_SIZE  512   // only consumed with SDCARD build option
 
 #if defined(FREE_RTOS)
 #define MIXER_TASK_PRIO        (tskIDLE_PRIORITY + 4)
 #define AUDIO_TASK_PRIO        (tskIDLE_PRIORITY + 3) // Note: FreeRTOSConfig.h defines software timers as priority 2
 #define MENUS_TASK_PRIO        (tskIDLE_PRIORITY + 1)
 #define CLI_TASK_PRIO          (tskIDLE_PRIORITY + 1)
+#define FILE_SINKS_TASK_PRIO   (tskIDLE_PRIORITY + 1)
 #else
 #define MIXER_TASK_PRIO        (4)
 #define AUDIO_TASK_PRIO        (2)
 #define MENUS_TASK_PRIO        (1)
 #define CLI_TASK_PRIO          (1)
+#define FILE_SINKS_TASK_PRIO   (1)
 #endif
 
 
@@ -62,6 +65,10 @@ extern TaskStack<AUDIO_STACK_SIZE> audioStack;
 extern TaskStack<CLI_STACK_SIZE> cliStack;
 #endif
 
+#if defined(SDCARD) && !defined(SIMU)
+extern TaskStack<FILE_SINKS_STACK_SIZE> fileSinksStack;
+#endif
+
 void tasksStart();
 
 extern volatile uint16_t timeForcePowerOffPressed;
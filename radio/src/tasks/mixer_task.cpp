@@ -216,6 +216,8 @@ TASK_FUNCTION(mixerTask)
       t0 = timersGetUsTick() - t0;
       if (t0 > maxMixerDuration)
         maxMixerDuration = t0;
+      if (mixerFadingModes && t0 > maxMixerFadeDuration)
+        maxMixerFadeDuration = t0;
     }
   }
 
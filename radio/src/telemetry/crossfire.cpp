@@ -258,11 +258,9 @@ void processCrossfireTelemetryFrame(uint8_t module, uint8_t* rxBuffer,
 
 #if defined(LUA)
     default:
-      if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(rxBufferCount - 2)) {
-        for (uint8_t i = 1; i < rxBufferCount - 1; i++) {
-          // destination address and CRC are skipped
-          luaInputTelemetryFifo->push(rxBuffer[i]);
-        }
+      if (luaInputTelemetryFifo) {
+        // destination address and CRC are skipped
+        luaInputTelemetryFifo->pushFrame(&rxBuffer[1], rxBufferCount - 2);
       }
       break;
 #endif
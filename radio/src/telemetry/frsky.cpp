@@ -100,3 +100,13 @@ void processFrskySportTelemetryData(uint8_t module, uint8_t data, uint8_t* buffe
     sportProcessTelemetryPacket(module, buffer, len);
   }
 }
+
+void processFrskySportTelemetryBuffer(uint8_t module, const uint8_t* data,
+                                      uint32_t size, uint8_t* buffer, uint8_t& len)
+{
+  for (uint32_t i = 0; i < size; i++) {
+    if (pushFrskyTelemetryData(true, data[i], buffer, len)) {
+      sportProcessTelemetryPacket(module, buffer, len);
+    }
+  }
+}
@@ -389,17 +389,13 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t module, uint8_t origin, const
         }
         else if (dataId >= DIY_STREAM_FIRST_ID && dataId <= DIY_STREAM_LAST_ID) {
 #if defined(LUA)
-          if (luaInputTelemetryFifo &&
-              luaInputTelemetryFifo->hasSpace(sizeof(SportTelemetryPacket))) {
-
+          if (luaInputTelemetryFifo) {
             SportTelemetryPacket luaPacket;
             luaPacket.physicalId = physicalId;
             luaPacket.primId = primId;
             luaPacket.dataId = dataId;
             luaPacket.value = data;
-            for (uint8_t i=0; i<sizeof(SportTelemetryPacket); i++) {
-              luaInputTelemetryFifo->push(luaPacket.raw[i]);
-            }
+            luaInputTelemetryFifo->pushFrame(luaPacket.raw, sizeof(luaPacket));
           }
 #endif
         }
@@ -431,15 +427,13 @@ void sportProcessTelemetryPacketWithoutCrc(uint8_t module, uint8_t origin, const
   }
 #if defined(LUA)
   else if (primId == 0x32) {
-    if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(sizeof(SportTelemetryPacket))) {
+    if (luaInputTelemetryFifo) {
       SportTelemetryPacket luaPacket;
       luaPacket.physicalId = physicalId;
       luaPacket.primId = primId;
       luaPacket.dataId = dataId;
       luaPacket.value = data;
-      for (uint8_t i=0; i<sizeof(SportTelemetryPacket); i++) {
-        luaInputTelemetryFifo->push(luaPacket.raw[i]);
-      }
+      luaInputTelemetryFifo->pushFrame(luaPacket.raw, sizeof(luaPacket));
     }
   }
 #endif
@@ -599,6 +599,13 @@ static void processMultiTelemetryByte(const uint8_t data, uint8_t module)
   }
 }
 
+void processMultiTelemetryBuffer(const uint8_t* data, uint32_t size, uint8_t module)
+{
+  while (size--) {
+    processMultiTelemetryData(*data++, module);
+  }
+}
+
 void processMultiTelemetryData(uint8_t data, uint8_t module)
 {
   uint8_t * rxBuffer = getTelemetryRxBuffer(module);
@@ -881,6 +881,48 @@ void processSpektrumTelemetryData(uint8_t module, uint8_t data,
   }
 }
 
+// Same as processSpektrumTelemetryData() for each byte, the bytes being
+// copied by packet parts
+void processSpektrumTelemetryBuffer(uint8_t module, const uint8_t *data,
+                                    uint32_t size, uint8_t *rxBuffer,
+                                    uint8_t &rxBufferCount)
+{
+  while (size > 0) {
+    if (rxBufferCount == 0) {
+      auto start = (const uint8_t *)memchr(data, 0xAA, size);
+      if (!start) {
+        TRACE("[SPK] invalid start byte 0x%02X", data[0]);
+        return;
+      }
+      size -= start - data;
+      data = start;
+    }
+
+    // the bind packets are identified by their second byte
+    uint8_t packetLength = SPEKTRUM_TELEMETRY_LENGTH;
+    if (rxBufferCount < 2)
+      packetLength = 2;
+    else if (rxBuffer[1] == 0x80 && DSM_BIND_PACKET_LENGTH < packetLength)
+      packetLength = DSM_BIND_PACKET_LENGTH;
+
+    uint32_t count = packetLength - rxBufferCount;
+    if (count > size) count = size;
+    memcpy(rxBuffer + rxBufferCount, data, count);
+    rxBufferCount += count;
+    data += count;
+    size -= count;
+
+    if (rxBufferCount >= 2 && rxBuffer[1] == 0x80 &&
+        rxBufferCount >= DSM_BIND_PACKET_LENGTH) {
+      processDSMBindPacket(module, rxBuffer + 2);
+      rxBufferCount = 0;
+    } else if (rxBufferCount >= SPEKTRUM_TELEMETRY_LENGTH) {
+      processSpektrumPacket(rxBuffer);
+      rxBufferCount = 0;
+    }
+  }
+}
+
 const SpektrumSensor *getSpektrumSensor(uint16_t pseudoId)
 {
   uint8_t startByte = (uint8_t) (pseudoId & 0xff);
@@ -23,6 +23,8 @@
 #define _SPEKTRUM_H
 
 void processSpektrumTelemetryData(uint8_t module, uint8_t data, uint8_t* rxBuffer, uint8_t& rxBufferCount);
+void processSpektrumTelemetryBuffer(uint8_t module, const uint8_t* data, uint32_t size,
+                                    uint8_t* rxBuffer, uint8_t& rxBufferCount);
 void spektrumSetDefault(int index, uint16_t id, uint8_t subId, uint8_t instance);
 
 // Used directly by multi telemetry protocol
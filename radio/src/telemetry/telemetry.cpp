@@ -36,6 +36,10 @@
   #include <FreeRTOS/include/timers.h>
 #endif
 
+#if defined(LOG_TELEMETRY)
+  #include "file_sink.h"
+#endif
+
 #include "spektrum.h"
 
 #if defined(CROSSFIRE)
@@ -178,6 +182,20 @@ void telemetryMirrorSend(uint8_t data)
   }
 }
 
+void telemetryMirrorSendBuffer(const uint8_t* data, uint32_t len)
+{
+  auto _sendByte = telemetryMirrorSendByte;
+  auto _ctx = telemetryMirrorSendByteCtx;
+
+  // byte per byte: the serial drivers may send a buffer
+  // asynchronously, while these bytes are about to be released
+  if (_sendByte) {
+    while (len--) {
+      _sendByte(_ctx, *data++);
+    }
+  }
+}
+
 #if !defined(SIMU)
 static TimerHandle_t telemetryTimer = nullptr;
 static StaticTimer_t telemetryTimerBuffer;
@@ -240,10 +258,8 @@ static void _poll_frame(void *pvParameter1, uint32_t ulParameter2)
   if (frame_len > 0) {
 
     LOG_TELEMETRY_WRITE_START();
-    for (int i = 0; i < frame_len; i++) {
-      telemetryMirrorSend(frame[i]);
-      LOG_TELEMETRY_WRITE_BYTE(frame[i]);
-    }
+    telemetryMirrorSendBuffer(frame, frame_len);
+    LOG_TELEMETRY_WRITE_BUFFER(frame, frame_len);
 
     uint8_t* rxBuffer = getTelemetryRxBuffer(module);
     uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
@@ -277,6 +293,25 @@ inline bool isBadAntennaDetected()
   return false;
 }
 
+// bytes read at once from the serial drivers without getBuffer()
+#define TELEMETRY_RX_CHUNK_SIZE  32
+
+static void processTelemetryBuffer(const etx_proto_driver_t* drv, void* ctx,
+                                   const uint8_t* data, uint32_t len,
+                                   uint8_t* rxBuffer, uint8_t* rxBufferCount)
+{
+  telemetryMirrorSendBuffer(data, len);
+  LOG_TELEMETRY_WRITE_BUFFER(data, len);
+
+  if (drv->processBuffer) {
+    drv->processBuffer(ctx, data, len, rxBuffer, rxBufferCount);
+  } else {
+    for (uint32_t i = 0; i < len; i++) {
+      drv->processData(ctx, data[i], rxBuffer, rxBufferCount);
+    }
+  }
+}
+
 static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv, void* ctx)
 {
   if (!drv || !drv->processData) return;
@@ -285,20 +320,41 @@ static inline void pollTelemetry(uint8_t module, const etx_proto_driver_t* drv,
   auto serial_drv = modulePortGetSerialDrv(mod_st->rx);
   auto serial_ctx = modulePortGetCtx(mod_st->rx);
 
-  if (!serial_drv  || !serial_ctx || !serial_drv->getByte)
+  if (!serial_drv || !serial_ctx)
     return;
 
   uint8_t* rxBuffer = getTelemetryRxBuffer(module);
   uint8_t& rxBufferCount = getTelemetryRxBufferCount(module);
 
-  uint8_t data;
-  if (serial_drv->getByte(serial_ctx, &data) > 0) {
-    LOG_TELEMETRY_WRITE_START();
-    do {
-      telemetryMirrorSend(data);
-      drv->processData(ctx, data, rxBuffer, &rxBufferCount);
-      LOG_TELEMETRY_WRITE_BYTE(data);
-    } while (serial_drv->getByte(serial_ctx, &data) > 0);
+  if (serial_drv->getBuffer && serial_drv->consumeBuffer) {
+    // the bytes are parsed where the driver received them
+    const uint8_t* data;
+    int len = serial_drv->getBuffer(serial_ctx, &data);
+    if (len > 0) {
+      LOG_TELEMETRY_WRITE_START();
+      do {
+        processTelemetryBuffer(drv, ctx, data, len, rxBuffer, &rxBufferCount);
+        serial_drv->consumeBuffer(serial_ctx, len);
+      } while ((len = serial_drv->getBuffer(serial_ctx, &data)) > 0);
+    }
+  } else if (serial_drv->getByte) {
+    uint8_t chunk[TELEMETRY_RX_CHUNK_SIZE];
+    uint32_t len = 0;
+    bool started = false;
+    while (true) {
+      while (len < sizeof(chunk) &&
+             serial_drv->getByte(serial_ctx, &chunk[len]) > 0) {
+        len++;
+      }
+      if (len == 0) break;
+      if (!started) {
+        LOG_TELEMETRY_WRITE_START();
+        started = true;
+      }
+      processTelemetryBuffer(drv, ctx, chunk, len, rxBuffer, &rxBufferCount);
+      if (len < sizeof(chunk)) break;
+      len = 0;
+    }
   }
 }
 
@@ -441,7 +497,7 @@ void telemetryReset()
 }
 
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
-extern FIL g_telemetryFile;
+extern FileSink telemetryLogSink;
 void logTelemetryWriteStart()
 {
   static tmr10ms_t lastTime = 0;
@@ -449,16 +505,32 @@ void logTelemetryWriteStart()
   if (lastTime != newTime) {
     struct gtm utm;
     gettime(&utm);
-    f_printf(&g_telemetryFile, "\r\n%4d-%02d-%02d,%02d:%02d:%02d.%02d0:",
-             utm.tm_year + TM_YEAR_BASE, utm.tm_mon + 1, utm.tm_mday,
-             utm.tm_hour, utm.tm_min, utm.tm_sec, g_ms100);
+    telemetryLogSink.print("\r\n%4d-%02d-%02d,%02d:%02d:%02d.%02d0:",
+                           utm.tm_year + TM_YEAR_BASE, utm.tm_mon + 1,
+                           utm.tm_mday, utm.tm_hour, utm.tm_min, utm.tm_sec,
+                           g_ms100);
+    telemetryLogSink.commit();
     lastTime = newTime;
   }
 }
 
-void logTelemetryWriteByte(uint8_t data)
+void logTelemetryWriteBuffer(const uint8_t* data, uint32_t len)
 {
-  f_printf(&g_telemetryFile, " %02X", data);
+  static const char hex[] = "0123456789ABCDEF";
+  char str[3 * 16];
+  while (len > 0) {
+    uint32_t count = len < 16 ? len : 16;
+    char* p = str;
+    for (uint32_t i = 0; i < count; i++) {
+      *p++ = ' ';
+      *p++ = hex[data[i] >> 4];
+      *p++ = hex[data[i] & 0x0F];
+    }
+    telemetryLogSink.write(str, p - str);
+    data += count;
+    len -= count;
+  }
+  telemetryLogSink.commit();
 }
 #endif
 
@@ -73,6 +73,9 @@ void telemetrySetMirrorCb(void* ctx, void (*fct)(void*, uint8_t));
 // Mirror telemetry byte
 void telemetryMirrorSend(uint8_t data);
 
+// Mirror telemetry bytes
+void telemetryMirrorSendBuffer(const uint8_t* data, uint32_t len);
+
 void telemetryWakeup();
 void telemetryReset();
 
@@ -124,6 +127,15 @@ void delTelemetryIndex(uint8_t index);
 int availableTelemetryIndex();
 int lastUsedTelemetryIndex();
 
+// The sensors lookup index used by setTelemetryValue() is invalidated by
+// storageDirty(EE_MODEL) and model load, and rebuilt on next use.
+void telemetrySensorsIndexInvalidate();
+
+#if defined(SIMU)
+// Looks the sensors up with the former scan of all sensors (benchmarks)
+extern bool telemetrySensorsLinearScan;
+#endif
+
 int32_t convertTelemetryValue(int32_t value, uint8_t unit, uint8_t prec, uint8_t destUnit, uint8_t destPrec);
 
 void frskySportSetDefault(int index, uint16_t id, uint8_t subId, uint8_t instance);
@@ -143,12 +155,12 @@ rxStatStruct *getRxStatLabels();
 
 #if defined(LOG_TELEMETRY) && !defined(SIMU)
 void logTelemetryWriteStart();
-void logTelemetryWriteByte(uint8_t data);
-#define LOG_TELEMETRY_WRITE_START()    logTelemetryWriteStart()
-#define LOG_TELEMETRY_WRITE_BYTE(data) logTelemetryWriteByte(data)
+void logTelemetryWriteBuffer(const uint8_t* data, uint32_t len);
+#define LOG_TELEMETRY_WRITE_START()             logTelemetryWriteStart()
+#define LOG_TELEMETRY_WRITE_BUFFER(data, len)   logTelemetryWriteBuffer(data, len)
 #else
 #define LOG_TELEMETRY_WRITE_START()
-#define LOG_TELEMETRY_WRITE_BYTE(data)
+#define LOG_TELEMETRY_WRITE_BUFFER(data, len)
 #endif
 #define TELEMETRY_OUTPUT_BUFFER_SIZE  64
 
@@ -502,34 +502,156 @@ int lastUsedTelemetryIndex()
   return -1;
 }
 
-template <class T>
-int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
-                      uint8_t instance, T value, uint32_t unit = 0,
-                      uint32_t prec = 0)
+// Index of the custom sensors by (id, subId). The sensors with the same
+// hash are chained in sensors order, the instance is still checked on
+// each of them as it may be updated on the fly (S.Port).
+#define TELEMETRY_SENSORS_HASH_SIZE 64
+
+struct TelemetrySensorsIndex {
+  uint8_t hash[TELEMETRY_SENSORS_HASH_SIZE];  // sensor index + 1
+  uint8_t next[MAX_TELEMETRY_SENSORS];        // sensor index + 1
+};
+
+// The index is used by the mixer task (telemetry) and by the Lua scripts.
+// It is built aside and copied into the copy not in use, which is then
+// published: a lookup is done again if its copy was rewritten meanwhile
+// (published twice).
+static TelemetrySensorsIndex _sensors_indexes[2];
+static volatile uint8_t _sensors_published = 0;  // bit 0: copy in use
+
+// the index is valid when both serials are the same
+static volatile uint8_t _sensors_serial = 1;
+static uint8_t _sensors_index_serial = 0;
+
+static_assert(MAX_TELEMETRY_SENSORS < 255, "sensor index must fit in uint8_t");
+
+void telemetrySensorsIndexInvalidate()
+{
+  _sensors_serial++;
+}
+
+static inline uint8_t getSensorHash(uint16_t id, uint8_t subId)
 {
-  bool sensorFound = false;
+  return (id ^ (id >> 4) ^ (id >> 8) ^ (subId << 2)) &
+         (TELEMETRY_SENSORS_HASH_SIZE - 1);
+}
 
-  for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+static void buildTelemetrySensorsIndex(TelemetrySensorsIndex & sensorsIndex)
+{
+  memclear(sensorsIndex.hash, sizeof(sensorsIndex.hash));
+
+  // backwards, so that each chain is in sensors order
+  for (int index = MAX_TELEMETRY_SENSORS - 1; index >= 0; index--) {
     TelemetrySensor &telemetrySensor = g_model.telemetrySensors[index];
+    sensorsIndex.next[index] = 0;
+    if (telemetrySensor.type == TELEM_TYPE_CUSTOM) {
+      uint8_t hash = getSensorHash(telemetrySensor.id, telemetrySensor.subId);
+      sensorsIndex.next[index] = sensorsIndex.hash[hash];
+      sensorsIndex.hash[hash] = index + 1;
+    }
+  }
+}
+
+static void updateTelemetrySensorsIndex()
+{
+#if defined(SIMU)
+  if (modelCachesAlwaysRebuild) telemetrySensorsIndexInvalidate();
+#endif
 
-    if (telemetrySensor.type == TELEM_TYPE_CUSTOM && telemetrySensor.id == id &&
-        telemetrySensor.subId == subId &&
-        (telemetrySensor.isSameInstance(protocol, instance) ||
-         g_model.ignoreSensorIds)) {
+  uint8_t serial = _sensors_serial;
+  if (serial == _sensors_index_serial)
+    return;
+
+  TelemetrySensorsIndex sensorsIndex;
+  buildTelemetrySensorsIndex(sensorsIndex);
+
+  // copy and publish at once, another task may build it as well
+  __disable_irq();
+  uint8_t published = _sensors_published + 1;
+  _sensors_indexes[published & 1] = sensorsIndex;
+  _sensors_published = published;
+  // an invalidation while building will trigger another build
+  _sensors_index_serial = serial;
+  __enable_irq();
+}
 
-      telemetryItems[index].setValue(telemetrySensor, value, unit, prec);
-      sensorFound = true;
-      // we continue search here, because sensors can share the same id and
-      // instance
+static inline bool isMatchingSensor(TelemetrySensor & telemetrySensor,
+                                    TelemetryProtocol protocol, uint16_t id,
+                                    uint8_t subId, uint8_t instance)
+{
+  return telemetrySensor.type == TELEM_TYPE_CUSTOM &&
+         telemetrySensor.id == id && telemetrySensor.subId == subId &&
+         (telemetrySensor.isSameInstance(protocol, instance) ||
+          g_model.ignoreSensorIds);
+}
+
+#if defined(SIMU)
+bool telemetrySensorsLinearScan = false;
+#endif
+
+// Indexes of the sensors matching (id, subId, instance), in sensors order
+static uint8_t findTelemetrySensors(TelemetryProtocol protocol, uint16_t id,
+                                    uint8_t subId, uint8_t instance,
+                                    uint8_t * sensors)
+{
+  uint8_t count, published;
+
+#if defined(SIMU)
+  if (telemetrySensorsLinearScan) {
+    count = 0;
+    for (int index = 0; index < MAX_TELEMETRY_SENSORS; index++) {
+      if (isMatchingSensor(g_model.telemetrySensors[index], protocol, id,
+                           subId, instance)) {
+        sensors[count++] = index;
+      }
+    }
+    return count;
+  }
+#endif
+
+  do {
+    published = _sensors_published;
+    const TelemetrySensorsIndex & sensorsIndex =
+        _sensors_indexes[published & 1];
+
+    count = 0;
+    uint8_t steps = 0;  // the chain may be broken if rewritten meanwhile
+    for (uint8_t next = sensorsIndex.hash[getSensorHash(id, subId)];
+         next && steps < MAX_TELEMETRY_SENSORS;
+         next = sensorsIndex.next[next - 1], steps++) {
+      int index = next - 1;
+      if (isMatchingSensor(g_model.telemetrySensors[index], protocol, id,
+                           subId, instance)) {
+        sensors[count++] = index;
+      }
     }
+  } while ((uint8_t)(_sensors_published - published) > 1);
+
+  return count;
+}
+
+template <class T>
+int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
+                      uint8_t instance, T value, uint32_t unit = 0,
+                      uint32_t prec = 0)
+{
+  updateTelemetrySensorsIndex();
+
+  // sensors can share the same id and instance
+  uint8_t sensors[MAX_TELEMETRY_SENSORS];
+  uint8_t count = findTelemetrySensors(protocol, id, subId, instance, sensors);
+  for (uint8_t i = 0; i < count; i++) {
+    telemetryItems[sensors[i]].setValue(g_model.telemetrySensors[sensors[i]],
+                                        value, unit, prec);
   }
 
-  if (sensorFound || !allowNewSensors) {
+  if (count > 0 || !allowNewSensors) {
     return -1;
   }
 
   int index = availableTelemetryIndex();
   if (index >= 0) {
+    luaFieldsCacheInvalidate();
     switch (protocol) {
       case PROTOCOL_TELEMETRY_FRSKY_SPORT:
         frskySportSetDefault(index, id, subId, instance);
@@ -585,14 +707,16 @@ int setTelemetryValue(TelemetryProtocol protocol, uint16_t id, uint8_t subId,
 
 #if defined(LUA)
      case PROTOCOL_TELEMETRY_LUA:
-        // Sensor will be initialized by calling function
-        // This drops the first value
+        // Sensor will be initialized by calling function, which
+        // invalidates the index then. This drops the first value
         return index;
 #endif
 
       default:
         return index;
     }
+    // once the sensor (id, subId) is set
+    telemetrySensorsIndexInvalidate();
     telemetryItems[index].setValue(g_model.telemetrySensors[index], value, unit, prec);
     return index;
   }
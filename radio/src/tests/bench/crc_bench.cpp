@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+// CRC throughput benchmarks (bench-crc target).
+//
+// Usage: bench-crc [iterations scale, default 1.0]
+
+#include "crc.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+static volatile uint32_t _bench_sink;
+static uint32_t _bench_step;
+
+// the size of a large model file
+static uint8_t _bench_data[8192];
+
+static void runCrc16()
+{
+  _bench_sink += crc16(CRC_1021, _bench_data, sizeof(_bench_data), _bench_sink);
+}
+
+static void runCrc16Bytes()
+{
+  _bench_sink += Crc<uint16_t, 0x1021, false, 1>::compute(
+      _bench_data, sizeof(_bench_data), _bench_sink);
+}
+
+static void runCrc16Slices8()
+{
+  _bench_sink += Crc<uint16_t, 0x1021, false, 8>::compute(
+      _bench_data, sizeof(_bench_data), _bench_sink);
+}
+
+// a CRSF frame
+static void runCrc8()
+{
+  _bench_sink += crc8(_bench_data + (_bench_step++ & 0xFF), 24);
+}
+
+struct Benchmark {
+  const char * name;
+  void (*run)();
+  uint32_t iterations;
+};
+
+static const Benchmark benchmarks[] = {
+  { "crc16 CRC_1021 8KB, CRC_SLICES", runCrc16, 20000 },
+  { "crc16 CRC_1021 8KB, byte per byte", runCrc16Bytes, 20000 },
+  { "crc16 CRC_1021 8KB, slicing-by-8", runCrc16Slices8, 20000 },
+  { "crc8 24 bytes", runCrc8, 10000000 },
+};
+
+int main(int argc, char ** argv)
+{
+  double scale = (argc > 1 ? atof(argv[1]) : 1.0);
+  if (scale <= 0)
+    scale = 1.0;
+
+  for (uint32_t i = 0; i < sizeof(_bench_data); i++) {
+    _bench_data[i] = i * 131 + 7;
+  }
+
+  for (const auto & bench : benchmarks) {
+    uint32_t iterations = bench.iterations * scale;
+    if (!iterations)
+      iterations = 1;
+
+    // warm up
+    bench.run();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      bench.run();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    printf("%-50s %10u iterations %10.1f ns/op\n", bench.name, iterations, ns / iterations);
+  }
+
+  return 0;
+}
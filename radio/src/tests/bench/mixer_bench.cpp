@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+// Mixer throughput benchmarks (bench-radio target), built with the
+// optimizations and without the sanitizers of gtests-radio.
+//
+// Usage: bench-radio [iterations scale, default 1.0]
+//
+// Each benchmark builds a synthetic model (worst cases of the radio
+// limits), then prints the time per call of the function measured.
+
+#include "opentx.h"
+#include "model_init.h"
+#include "mixes.h"
+#include "switches.h"
+#include "hal/adc_driver.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+extern const etx_hal_adc_driver_t simu_adc_driver;
+extern void anaSetFiltered(uint8_t chan, uint16_t val);
+
+uint16_t simu_get_analog(uint8_t idx)
+{
+  return 0;
+}
+
+static volatile int32_t _bench_sink;
+static uint32_t _bench_step;
+static uint8_t _bench_curves = 1;
+
+static void resetModel()
+{
+  modelCachesAlwaysRebuild = false;
+  generalDefault();
+  memset(&g_model, 0, sizeof(g_model));
+  setModelDefaults();
+  memset(channelOutputs, 0, sizeof(channelOutputs));
+  memset(chans, 0, sizeof(chans));
+  memset(ex_chans, 0, sizeof(ex_chans));
+  memset(act, 0, sizeof(act));
+  memset(swOn, 0, sizeof(swOn));
+  mixerCurrentFlightMode = lastFlightMode = 0;
+  logicalSwitchesReset();
+}
+
+// Moves the sticks a bit on each call, so that the work is not constant
+static void moveSticks()
+{
+  _bench_step++;
+  for (uint8_t i = 0; i < adcGetMaxInputs(ADC_INPUT_MAIN); i++) {
+    anaSetFiltered(i, (_bench_step * 37 + i * 512) % 4096);
+  }
+}
+
+static uint8_t setSmoothCurves()
+{
+  uint8_t count = min<int>(MAX_CURVES, MAX_CURVE_POINTS / MAX_POINTS_PER_CURVE);
+  for (uint8_t i = 0; i < count; i++) {
+    g_model.curves[i].type = CURVE_TYPE_STANDARD;
+    g_model.curves[i].smooth = 1;
+    g_model.curves[i].points = MAX_POINTS_PER_CURVE - 5;
+  }
+  loadCurves();
+  for (uint8_t i = 0; i < count; i++) {
+    int8_t * points = curveAddress(i);
+    for (uint8_t p = 0; p < MAX_POINTS_PER_CURVE; p++) {
+      points[p] = ((p * 53 + i * 17) % 201) - 100;
+    }
+  }
+  _bench_curves = count;
+  return count;
+}
+
+static void setupMixes()
+{
+  uint8_t curves = setSmoothCurves();
+
+  for (uint8_t i = 0; i < MAX_MIXERS; i++) {
+    MixData * mix = mixAddress(i);
+    mix->destCh = i / 2;
+    mix->mltpx = MLTPX_ADD;
+    if (i & 1) {
+      // channel chain: each channel uses the previous one
+      mix->srcRaw = (i > 1 ? MIXSRC_FIRST_CH + i / 2 - 1 : MIXSRC_FIRST_STICK);
+      mix->weight = 50;
+    }
+    else {
+      mix->srcRaw = MIXSRC_FIRST_STICK + (i / 2) % MAX_STICKS;
+#if defined(GVARS)
+      mix->weight = GV_CALC_VALUE_IDX_POS(i % MAX_GVARS, GV1_LARGE);
+#else
+      mix->weight = 100;
+#endif
+      mix->curve.type = CURVE_REF_CUSTOM;
+      mix->curve.value = i % curves;
+      mix->offset = 5;
+    }
+  }
+
+#if defined(GVARS)
+  for (uint8_t i = 0; i < MAX_GVARS; i++) {
+    g_model.flightModeData[0].gvars[i] = 80 + i;
+  }
+#endif
+
+  storageDirty(EE_MODEL);
+}
+
+static void setupFlightModesFades()
+{
+  setupMixes();
+
+  for (uint8_t i = 0; i < MAX_FLIGHT_MODES; i++) {
+    g_model.flightModeData[i].fadeIn = 10;
+    g_model.flightModeData[i].fadeOut = 10;
+    if (i > 0)
+      g_model.flightModeData[i].swtch = SWSRC_FIRST_LOGICAL_SWITCH + i - 1;
+  }
+
+  // timer i is on and off for i + 1 ticks (100ms), so that the flight
+  // mode changes every 10 evaluations (see runFlightModes())
+  for (uint8_t i = 0; i + 1 < MAX_FLIGHT_MODES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    ls->func = LS_FUNC_TIMER;
+    ls->v1 = -128 + i;
+    ls->v2 = -128 + i;
+  }
+
+  storageDirty(EE_MODEL);
+}
+
+static void setupLogicalSwitches()
+{
+  for (uint8_t i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    switch (i % 4) {
+      case 0:
+        ls->func = LS_FUNC_VPOS;
+        ls->v1 = MIXSRC_FIRST_STICK + (i / 4) % MAX_STICKS;
+        ls->v2 = (i % 50) - 25;
+        break;
+      case 1:
+        ls->func = LS_FUNC_GREATER;
+        ls->v1 = MIXSRC_FIRST_STICK + (i / 4) % MAX_STICKS;
+        ls->v2 = MIXSRC_FIRST_STICK + (i / 4 + 1) % MAX_STICKS;
+        break;
+      case 2:
+        // uses the next logical switch (evaluation order)
+        ls->func = LS_FUNC_AND;
+        ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 2;
+        ls->v2 = SWSRC_FIRST_LOGICAL_SWITCH + i + 1;
+        break;
+      default:
+        ls->func = LS_FUNC_ADIFFEGREATER;
+        ls->v1 = MIXSRC_FIRST_STICK + (i / 4) % MAX_STICKS;
+        ls->v2 = 10;
+        ls->delay = 5;
+        break;
+    }
+  }
+  storageDirty(EE_MODEL);
+}
+
+static void setupFunctions()
+{
+  setupLogicalSwitches();
+  for (uint8_t i = 0; i < MAX_SPECIAL_FUNCTIONS; i++) {
+    CustomFunctionData * cfn = &g_model.customFn[i];
+    cfn->swtch = SWSRC_FIRST_LOGICAL_SWITCH + i % MAX_LOGICAL_SWITCHES;
+    CFN_ACTIVE(cfn) = 1;
+    if (i & 1) {
+      cfn->func = FUNC_OVERRIDE_CHANNEL;
+      CFN_CH_INDEX(cfn) = i % MAX_OUTPUT_CHANNELS;
+      CFN_PARAM(cfn) = i;
+    }
+#if defined(GVARS)
+    else {
+      cfn->func = FUNC_ADJUST_GVAR;
+      CFN_GVAR_INDEX(cfn) = i % MAX_GVARS;
+      CFN_GVAR_MODE(cfn) = FUNC_ADJUST_GVAR_SOURCE;
+      CFN_PARAM(cfn) = MIXSRC_FIRST_STICK + i % MAX_STICKS;
+    }
+#endif
+  }
+  storageDirty(EE_MODEL);
+}
+
+static void runEvalMixes()
+{
+  moveSticks();
+  evalMixes(1);
+}
+
+// evalMixes() is called every 10ms, and the LS timers are ticked every 100ms
+static void runFlightModes()
+{
+  runEvalMixes();
+  if (_bench_step % 10 == 0)
+    logicalSwitchesTimerTick();
+}
+
+static void runLogicalSwitches()
+{
+  moveSticks();
+  evalLogicalSwitches();
+  logicalSwitchesTimerTick();
+}
+
+static void runApplyCurve()
+{
+  CurveRef curve;
+  curve.type = CURVE_REF_CUSTOM;
+  curve.value = _bench_step % _bench_curves;
+  _bench_step++;
+  _bench_sink += applyCurve((int)(_bench_step * 7 % (2 * RESX)) - RESX, curve);
+}
+
+static void runFunctions()
+{
+  moveSticks();
+  evalLogicalSwitches();
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+}
+
+struct Benchmark {
+  const char * name;
+  void (*setup)();
+  void (*run)();
+  uint32_t iterations;
+};
+
+static void setupCurves()
+{
+  setSmoothCurves();
+  storageDirty(EE_MODEL);
+}
+
+static const Benchmark benchmarks[] = {
+  { "evalMixes, default model", nullptr, runEvalMixes, 200000 },
+  { "evalMixes, 64 mixes + chains + curves + GVARs", setupMixes, runEvalMixes, 100000 },
+  { "evalMixes, flight modes fades", setupFlightModesFades, runFlightModes, 100000 },
+  { "evalLogicalSwitches + timer tick, 64 LS", setupLogicalSwitches, runLogicalSwitches, 1000000 },
+  { "applyCurve, smooth curves", setupCurves, runApplyCurve, 10000000 },
+  { "evalFunctions, 64 SF", setupFunctions, runFunctions, 1000000 },
+};
+
+int main(int argc, char ** argv)
+{
+  double scale = (argc > 1 ? atof(argv[1]) : 1.0);
+  if (scale <= 0)
+    scale = 1.0;
+
+  simuInit();
+  adcInit(&simu_adc_driver);
+
+  for (const auto & bench : benchmarks) {
+    resetModel();
+    if (bench.setup)
+      bench.setup();
+
+    uint32_t iterations = bench.iterations * scale;
+    if (!iterations)
+      iterations = 1;
+
+    // warm up (caches and plans built)
+    bench.run();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      bench.run();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    printf("%-50s %10u iterations %10.1f ns/op\n", bench.name, iterations, ns / iterations);
+  }
+
+  return 0;
+}
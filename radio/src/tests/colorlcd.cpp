@@ -24,6 +24,8 @@
 #if defined(COLORLCD)
 
 #include "colors.h"
+#include "location.h"
+#include "gui/colorlcd/thumbnail_cache.h"
 
 TEST(color, RGB)
 {
@@ -52,4 +54,151 @@ TEST(color, ARGB)
   EXPECT_EQ(ARGB(128, 30, 40, 150), (uint16_t)0x8129);
 }
 
+static int countThumbnails(bool remove)
+{
+  int count = 0;
+  DIR dir;
+  FILINFO fno;
+  if (f_opendir(&dir, THUMBNAILS_PATH) != FR_OK) return 0;
+  while (f_readdir(&dir, &fno) == FR_OK && fno.fname[0]) {
+    if (remove) {
+      char path[sizeof(THUMBNAILS_PATH) + FF_MAX_LFN + 1];
+      strAppend(strAppend(path, THUMBNAILS_PATH PATH_SEPARATOR), fno.fname);
+      f_unlink(path);
+    }
+    count++;
+  }
+  f_closedir(&dir);
+  return count;
+}
+
+// copies a test bitmap to /IMAGES/thumbtest.png
+static void copyThumbnailSource(const char* image)
+{
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(BITMAPS_PATH);
+
+  std::string srcPath = std::string(TESTS_PATH "/images/color/") + image;
+  FILE* src = fopen(srcPath.c_str(), "rb");
+  ASSERT_NE(src, nullptr);
+  FIL dst;
+  ASSERT_EQ(f_open(&dst, BITMAPS_PATH "/thumbtest.png",
+                   FA_CREATE_ALWAYS | FA_WRITE), FR_OK);
+  uint8_t buf[512];
+  size_t len;
+  UINT written;
+  while ((len = fread(buf, 1, sizeof(buf), src)) > 0)
+    f_write(&dst, buf, len, &written);
+  f_close(&dst);
+  fclose(src);
+}
+
+// overwrites the last pixel of the (only) thumbnail file
+static void setThumbnailFileLastPixel(uint16_t value)
+{
+  DIR dir;
+  FILINFO fno;
+  ASSERT_EQ(f_opendir(&dir, THUMBNAILS_PATH), FR_OK);
+  ASSERT_EQ(f_readdir(&dir, &fno), FR_OK);
+  f_closedir(&dir);
+  ASSERT_NE(fno.fname[0], 0);
+
+  char path[sizeof(THUMBNAILS_PATH) + FF_MAX_LFN + 1];
+  strAppend(strAppend(path, THUMBNAILS_PATH PATH_SEPARATOR), fno.fname);
+  FIL file;
+  ASSERT_EQ(f_open(&file, path, FA_OPEN_EXISTING | FA_WRITE), FR_OK);
+  UINT written;
+  f_lseek(&file, f_size(&file) - sizeof(value));
+  f_write(&file, &value, sizeof(value), &written);
+  f_close(&file);
+}
+
+static uint16_t lastPixel(const BitmapBuffer* bitmap)
+{
+  return bitmap->getData()[bitmap->width() * bitmap->height() - 1];
+}
+
+TEST(ThumbnailCache, bgColor)
+{
+  copyThumbnailSource("edgetx.png");
+  thumbnailCache.clear();
+  countThumbnails(true);
+
+  auto black = thumbnailCache.get("thumbtest.png", 32, 24, RGB2FLAGS(0, 0, 0));
+  auto white =
+      thumbnailCache.get("thumbtest.png", 32, 24, RGB2FLAGS(255, 255, 255));
+  ASSERT_NE(black, nullptr);
+  ASSERT_NE(white, nullptr);
+  EXPECT_NE(black, white);
+  thumbnailCache.release(black);
+  thumbnailCache.release(white);
+
+  // each color has its own thumbnail file
+  EXPECT_EQ(countThumbnails(false), 2);
+
+  thumbnailCache.clear();
+  countThumbnails(true);
+  f_unlink(BITMAPS_PATH "/thumbtest.png");
+}
+
+TEST(ThumbnailCache, reloadFromDisk)
+{
+  copyThumbnailSource("edgetx.png");
+  thumbnailCache.clear();
+  countThumbnails(true);
+
+  auto thumbnail = thumbnailCache.get("thumbtest.png", 32, 24, 0);
+  ASSERT_NE(thumbnail, nullptr);
+  EXPECT_EQ(thumbnail, thumbnailCache.get("thumbtest.png", 32, 24, 0));
+  thumbnailCache.release(thumbnail);
+  thumbnailCache.release(thumbnail);
+  EXPECT_EQ(countThumbnails(false), 1);
+
+  // once freed, the thumbnail is read from its file, not decoded again
+  uint16_t marker = lastPixel(thumbnail) ^ 0xFFFF;
+  setThumbnailFileLastPixel(marker);
+  thumbnailCache.clear();
+  thumbnail = thumbnailCache.get("thumbtest.png", 32, 24, 0);
+  ASSERT_NE(thumbnail, nullptr);
+  EXPECT_EQ(lastPixel(thumbnail), marker);
+  thumbnailCache.release(thumbnail);
+
+  thumbnailCache.clear();
+  countThumbnails(true);
+  f_unlink(BITMAPS_PATH "/thumbtest.png");
+}
+
+TEST(ThumbnailCache, sourceChanged)
+{
+  copyThumbnailSource("edgetx.png");
+  thumbnailCache.clear();
+  countThumbnails(true);
+
+  auto thumbnail = thumbnailCache.get("thumbtest.png", 32, 24, 0);
+  ASSERT_NE(thumbnail, nullptr);
+  uint16_t marker = lastPixel(thumbnail) ^ 0xFFFF;
+  setThumbnailFileLastPixel(marker);
+
+  // another bitmap with the same name: neither the thumbnail in use nor
+  // its file are used, the file is replaced
+  copyThumbnailSource("bitmap_480x272.png");
+  auto changed = thumbnailCache.get("thumbtest.png", 32, 24, 0);
+  ASSERT_NE(changed, nullptr);
+  EXPECT_NE(changed, thumbnail);
+  EXPECT_NE(lastPixel(changed), marker);
+  thumbnailCache.release(thumbnail);
+  thumbnailCache.release(changed);
+  EXPECT_EQ(countThumbnails(false), 1);
+
+  thumbnailCache.clear();
+  changed = thumbnailCache.get("thumbtest.png", 32, 24, 0);
+  ASSERT_NE(changed, nullptr);
+  EXPECT_NE(lastPixel(changed), marker);
+  thumbnailCache.release(changed);
+
+  thumbnailCache.clear();
+  countThumbnails(true);
+  f_unlink(BITMAPS_PATH "/thumbtest.png");
+}
+
 #endif
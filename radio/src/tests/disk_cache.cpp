@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(DISK_CACHE)
+
+#include "disk_cache.h"
+
+// a disk which doesn't end on a cache block
+#define TEST_SECTOR_SIZE   FF_MAX_SS
+#define TEST_DISK_BLOCKS   40
+#define TEST_DISK_SECTORS  (TEST_DISK_BLOCKS * DISK_CACHE_BLOCK_SECTORS + 5)
+
+static uint8_t fakeDisk[TEST_DISK_SECTORS * TEST_SECTOR_SIZE];
+static std::vector<std::pair<DWORD, UINT>> fakeReads;
+static bool fakeWriteError;
+static bool fakeOutOfRange;
+
+static DRESULT fakeRead(BYTE, BYTE* buff, DWORD sector, UINT count)
+{
+  fakeReads.push_back({sector, count});
+  if (sector + count > TEST_DISK_SECTORS) {
+    fakeOutOfRange = true;
+    return RES_PARERR;
+  }
+  memcpy(buff, &fakeDisk[sector * TEST_SECTOR_SIZE], count * TEST_SECTOR_SIZE);
+  return RES_OK;
+}
+
+static DRESULT fakeWrite(BYTE, const BYTE* buff, DWORD sector, UINT count)
+{
+  if (fakeWriteError) return RES_ERROR;
+  if (sector + count > TEST_DISK_SECTORS) {
+    fakeOutOfRange = true;
+    return RES_PARERR;
+  }
+  memcpy(&fakeDisk[sector * TEST_SECTOR_SIZE], buff, count * TEST_SECTOR_SIZE);
+  return RES_OK;
+}
+
+static DRESULT fakeIoctl(BYTE, BYTE cmd, void* buff)
+{
+  if (cmd != GET_SECTOR_COUNT) return RES_PARERR;
+  *(DWORD*)buff = TEST_DISK_SECTORS;
+  return RES_OK;
+}
+
+static const diskio_driver_t fakeDriver = {
+  .initialize = nullptr,
+  .deinit = nullptr,
+  .status = nullptr,
+  .read = fakeRead,
+  .write = fakeWrite,
+  .ioctl = fakeIoctl,
+};
+
+static uint8_t buffer[2 * DISK_CACHE_BLOCK_SECTORS * TEST_SECTOR_SIZE];
+
+class DiskCacheTest : public testing::Test
+{
+ protected:
+  // its blocks buffer is only allocated once
+  static DiskCache cache;
+
+  void SetUp() override
+  {
+    for (unsigned i = 0; i < sizeof(fakeDisk); i++) {
+      DWORD sector = i / TEST_SECTOR_SIZE;
+      fakeDisk[i] = sector * 31 + (sector >> 3) + i * 7;
+    }
+    fakeReads.clear();
+    fakeWriteError = false;
+    fakeOutOfRange = false;
+
+    cache.initialize(&fakeDriver);
+    cache.clear();
+  }
+
+  void TearDown() override
+  {
+    EXPECT_FALSE(fakeOutOfRange);
+  }
+
+  static bool isDiskContent(const uint8_t* buff, DWORD sector, UINT count)
+  {
+    return !memcmp(buff, &fakeDisk[sector * TEST_SECTOR_SIZE],
+                   count * TEST_SECTOR_SIZE);
+  }
+
+  const DiskCacheStats& stats() { return cache.getStats(); }
+};
+
+DiskCache DiskCacheTest::cache;
+
+TEST_F(DiskCacheTest, unalignedReads)
+{
+  // inside a block
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 3, 5));
+  EXPECT_TRUE(isDiskContent(buffer, 3, 5));
+  ASSERT_EQ(1u, fakeReads.size());
+  EXPECT_EQ(0u, fakeReads[0].first);
+  EXPECT_EQ((UINT)DISK_CACHE_BLOCK_SECTORS, fakeReads[0].second);
+
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 7, 9));
+  EXPECT_TRUE(isDiskContent(buffer, 7, 9));
+  EXPECT_EQ(1u, fakeReads.size());
+  EXPECT_EQ(1u, stats().noHits);
+
+  // across 2 blocks
+  const DWORD sector = 5 * DISK_CACHE_BLOCK_SECTORS - 3;
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, sector, 7));
+  EXPECT_TRUE(isDiskContent(buffer, sector, 7));
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, sector - 1, 9));
+  EXPECT_TRUE(isDiskContent(buffer, sector - 1, 9));
+
+  // bigger than a block: not cached
+  size_t reads = fakeReads.size();
+  ASSERT_EQ(RES_OK,
+            cache.read(0, buffer, 10, DISK_CACHE_BLOCK_SECTORS + 3));
+  EXPECT_TRUE(isDiskContent(buffer, 10, DISK_CACHE_BLOCK_SECTORS + 3));
+  ASSERT_EQ(reads + 1, fakeReads.size());
+  EXPECT_EQ(10u, fakeReads.back().first);
+}
+
+TEST_F(DiskCacheTest, writeCoherence)
+{
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 0, DISK_CACHE_BLOCK_SECTORS));
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, DISK_CACHE_BLOCK_SECTORS, 1));
+
+  // over the end of block 0 and the start of block 1, both cached
+  uint8_t data[3 * TEST_SECTOR_SIZE];
+  memset(data, 0xA5, sizeof(data));
+  const DWORD sector = DISK_CACHE_BLOCK_SECTORS - 2;
+  ASSERT_EQ(RES_OK, cache.write(0, data, sector, 3));
+  EXPECT_TRUE(isDiskContent(data, sector, 3));
+
+  size_t reads = fakeReads.size();
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 0, DISK_CACHE_BLOCK_SECTORS));
+  ASSERT_EQ(RES_OK, cache.read(0, buffer + DISK_CACHE_BLOCK_SECTORS *
+                                               TEST_SECTOR_SIZE,
+                               DISK_CACHE_BLOCK_SECTORS,
+                               DISK_CACHE_BLOCK_SECTORS));
+  EXPECT_EQ(reads, fakeReads.size());
+  EXPECT_TRUE(isDiskContent(buffer, 0, 2 * DISK_CACHE_BLOCK_SECTORS));
+  EXPECT_FALSE(memcmp(buffer + sector * TEST_SECTOR_SIZE, data, sizeof(data)));
+
+  // a failed write drops the cached copy
+  fakeWriteError = true;
+  memset(data, 0x5A, sizeof(data));
+  EXPECT_NE(RES_OK, cache.write(0, data, 2, 1));
+  fakeWriteError = false;
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 2, 1));
+  EXPECT_EQ(reads + 1, fakeReads.size());
+  EXPECT_TRUE(isDiskContent(buffer, 2, 1));
+}
+
+TEST_F(DiskCacheTest, readAheadAtDiskEnd)
+{
+  // sequential reads of the whole disk
+  for (DWORD sector = 0; sector < TEST_DISK_SECTORS;
+       sector += DISK_CACHE_BLOCK_SECTORS) {
+    UINT count = std::min<DWORD>(DISK_CACHE_BLOCK_SECTORS,
+                                 TEST_DISK_SECTORS - sector);
+    ASSERT_EQ(RES_OK, cache.read(0, buffer, sector, count));
+    EXPECT_TRUE(isDiskContent(buffer, sector, count));
+  }
+  EXPECT_GT(stats().noReadAheads, 0u);
+  EXPECT_EQ(stats().noReadAheads, stats().noReadAheadHits);
+
+  // the last partial block is read directly
+  EXPECT_EQ((DWORD)TEST_DISK_BLOCKS * DISK_CACHE_BLOCK_SECTORS,
+            fakeReads.back().first);
+  EXPECT_EQ(5u, fakeReads.back().second);
+
+  // no read ahead of the partial block after the last full one
+  cache.clear();
+  fakeReads.clear();
+  const DWORD last = (TEST_DISK_BLOCKS - 1) * DISK_CACHE_BLOCK_SECTORS;
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, last - DISK_CACHE_BLOCK_SECTORS, 1));
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, last, DISK_CACHE_BLOCK_SECTORS));
+  EXPECT_TRUE(isDiskContent(buffer, last, DISK_CACHE_BLOCK_SECTORS));
+  EXPECT_EQ(last, fakeReads.back().first);
+  EXPECT_EQ((UINT)DISK_CACHE_BLOCK_SECTORS, fakeReads.back().second);
+  EXPECT_EQ(0u, stats().noReadAheads);
+}
+
+TEST_F(DiskCacheTest, pinnedSectors)
+{
+  cache.setPinnedSectors(0, 2 * DISK_CACHE_BLOCK_SECTORS);
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 1, 1));
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, DISK_CACHE_BLOCK_SECTORS + 1, 1));
+  EXPECT_EQ(2u, stats().noPinned);
+
+  // more blocks than the cache holds, backwards so without read ahead
+  for (int pass = 0; pass < 2; pass++) {
+    for (DWORD block = TEST_DISK_BLOCKS - 1; block >= 2; block--) {
+      ASSERT_EQ(RES_OK,
+                cache.read(0, buffer, block * DISK_CACHE_BLOCK_SECTORS, 1));
+      EXPECT_TRUE(isDiskContent(buffer, block * DISK_CACHE_BLOCK_SECTORS, 1));
+    }
+  }
+  EXPECT_GT(stats().noEvictions, 0u);
+
+  // the pinned blocks were not replaced
+  size_t reads = fakeReads.size();
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, 0, DISK_CACHE_BLOCK_SECTORS));
+  EXPECT_TRUE(isDiskContent(buffer, 0, DISK_CACHE_BLOCK_SECTORS));
+  ASSERT_EQ(RES_OK, cache.read(0, buffer, DISK_CACHE_BLOCK_SECTORS, 2));
+  EXPECT_TRUE(isDiskContent(buffer, DISK_CACHE_BLOCK_SECTORS, 2));
+  EXPECT_EQ(reads, fakeReads.size());
+  EXPECT_EQ(2u, stats().noPinned);
+}
+
+#endif
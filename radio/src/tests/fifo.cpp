@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <thread>
+
+#include "gtests.h"
+#include "fifo.h"
+
+TEST(Fifo, pushPop)
+{
+  Fifo<uint8_t, 16> fifo;
+  uint8_t data[32], out[32];
+  for (int i = 0; i < 32; i++) data[i] = i;
+
+  // the whole buffer can be used
+  EXPECT_EQ(16U, fifo.push(data, 20));
+  EXPECT_TRUE(fifo.isFull());
+  EXPECT_FALSE(fifo.push(data[0]));
+  EXPECT_EQ(5U, fifo.getOverflows());
+  EXPECT_EQ(16U, fifo.getHighWatermark());
+
+  EXPECT_EQ(10U, fifo.pop(out, 10));
+  EXPECT_EQ(0, memcmp(data, out, 10));
+
+  // across the end of the buffer
+  EXPECT_EQ(10U, fifo.push(data + 16, 10));
+  EXPECT_EQ(16U, fifo.size());
+  EXPECT_EQ(16U, fifo.pop(out, sizeof(out)));
+  EXPECT_EQ(0, memcmp(data + 10, out, 16));
+  EXPECT_TRUE(fifo.isEmpty());
+
+  uint8_t byte;
+  EXPECT_FALSE(fifo.pop(byte));
+  EXPECT_TRUE(fifo.push(42));
+  EXPECT_TRUE(fifo.probe(byte));
+  EXPECT_EQ(42, byte);
+  fifo.skip();
+  EXPECT_TRUE(fifo.isEmpty());
+
+  fifo.resetStats();
+  EXPECT_EQ(0U, fifo.getOverflows());
+  EXPECT_EQ(0U, fifo.getHighWatermark());
+}
+
+TEST(Fifo, contiguous)
+{
+  Fifo<uint8_t, 16> fifo;
+  uint8_t data[16];
+  for (int i = 0; i < 16; i++) data[i] = i;
+
+  fifo.push(data, 12);
+  fifo.pop(data, 8);
+
+  // 4 bytes after the first 12, then 8 at the start
+  uint8_t * w;
+  EXPECT_EQ(4U, fifo.reserveContiguous(&w));
+  for (int i = 0; i < 4; i++) w[i] = 100 + i;
+  fifo.commit(4);
+  EXPECT_EQ(8U, fifo.reserveContiguous(&w));
+  for (int i = 0; i < 3; i++) w[i] = 104 + i;
+  fifo.commit(3);
+
+  const uint8_t * r;
+  EXPECT_EQ(8U, fifo.peekContiguous(&r));
+  EXPECT_EQ(8, r[0]);
+  EXPECT_EQ(103, r[7]);
+  fifo.consume(8);
+  EXPECT_EQ(3U, fifo.peekContiguous(&r));
+  EXPECT_EQ(104, r[0]);
+  fifo.consume(3);
+  EXPECT_EQ(0U, fifo.peekContiguous(&r));
+}
+
+TEST(Fifo, pushFrame)
+{
+  Fifo<uint8_t, 16> fifo;
+  uint8_t data[10], out[16];
+  for (int i = 0; i < 10; i++) data[i] = i;
+
+  EXPECT_TRUE(fifo.pushFrame(data, 10));
+  // not enough space: nothing is pushed
+  EXPECT_FALSE(fifo.pushFrame(data, 7));
+  EXPECT_EQ(10U, fifo.size());
+  EXPECT_EQ(7U, fifo.getOverflows());
+  EXPECT_EQ(1U, fifo.getRejectedFrames());
+
+  // across the end of the buffer
+  EXPECT_EQ(8U, fifo.pop(out, 8));
+  EXPECT_TRUE(fifo.pushFrame(data, 10));
+  EXPECT_EQ(12U, fifo.size());
+  EXPECT_EQ(12U, fifo.pop(out, sizeof(out)));
+  EXPECT_EQ(8, out[0]);
+  EXPECT_EQ(0, memcmp(data, out + 2, 10));
+  EXPECT_EQ(1U, fifo.getRejectedFrames());
+
+  fifo.resetStats();
+  EXPECT_EQ(0U, fifo.getRejectedFrames());
+}
+
+TEST(Fifo, producerConsumer)
+{
+  static Fifo<uint32_t, 64> fifo;
+  const uint32_t count = 100000;
+
+  std::thread producer([&]() {
+    uint32_t values[7];
+    uint32_t next = 0;
+    while (next < count) {
+      uint32_t n = 0;
+      while (n < 7 && next + n < count) {
+        values[n] = next + n;
+        n++;
+      }
+      uint32_t pushed = fifo.push(values, n);
+      if (!pushed) std::this_thread::yield();
+      next += pushed;
+    }
+  });
+
+  uint32_t expected = 0;
+  bool ordered = true;
+  while (expected < count) {
+    uint32_t values[5];
+    uint32_t n = fifo.pop(values, 5);
+    if (!n) std::this_thread::yield();
+    for (uint32_t i = 0; i < n; i++) {
+      ordered &= (values[i] == expected++);
+    }
+  }
+  producer.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(fifo.isEmpty());
+  EXPECT_LE(fifo.getHighWatermark(), 64U);
+}
@@ -19,6 +19,7 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
 #include "gtests.h"
 
 void frskyDProcessPacket(const uint8_t *packet);
@@ -209,6 +210,43 @@ TEST(FrSkySPORT, FrSkyDCells)
   }
 }
 
+TEST(FrSkySPORT, processBuffer)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  // the FrSkyDCells packets, received twice
+  const uint8_t packets[] = {
+    0x7E, 0x98, 0x10, 0x06, 0x00, 0x07, 0xD0, 0x00, 0x00, 0x12,
+    0x7E, 0x98, 0x10, 0x06, 0x00, 0x17, 0xD0, 0x00, 0x00, 0x02,
+    0x7E, 0x98, 0x10, 0x06, 0x00, 0x27, 0xD0, 0x00, 0x00, 0xF1,
+    0x7E, 0x98, 0x10, 0x06, 0x00, 0x07, 0xD0, 0x00, 0x00, 0x12,
+    0x7E, 0x98, 0x10, 0x06, 0x00, 0x17, 0xD0, 0x00, 0x00, 0x02,
+    0x7E, 0x98, 0x10, 0x06, 0x00, 0x27, 0xD0, 0x00, 0x00, 0xF1,
+  };
+
+  // spans which do not match the packets limits
+  uint8_t buffer[TELEMETRY_RX_PACKET_SIZE];
+  uint8_t len = 0;
+  const uint32_t spans[] = { 1, 3, 7, 13, 16, 20 };
+  uint32_t pos = 0;
+  for (uint32_t span : spans) {
+    processFrskySportTelemetryBuffer(0, packets + pos, span, buffer, len);
+    pos += span;
+  }
+  EXPECT_EQ(pos, sizeof(packets));
+
+  EXPECT_EQ(telemetryItems[0].cells.count, 3);
+  EXPECT_EQ(telemetryItems[0].value, 1200);
+  for (int i=0; i<3; i++) {
+    EXPECT_EQ(telemetryItems[0].cells.values[i].state, 1);
+    EXPECT_EQ(telemetryItems[0].cells.values[i].value, 400);
+  }
+}
+
 TEST(FrSkySPORT, frskySetCellVoltage)
 {
   uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
@@ -530,3 +568,203 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+static void sendSportPacket(uint8_t physId, uint16_t dataId, uint32_t data)
+{
+  uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
+  packet[0] = physId;
+  packet[1] = 0x10; // DATA_FRAME
+  *((uint16_t *)(packet+2)) = dataId;
+  *((uint32_t *)(packet+4)) = data;
+  setSportPacketCrc(packet);
+  sportProcessTelemetryPacket(0, packet, sizeof(packet));
+}
+
+TEST(FrSkySPORT, sensorsIndexRename)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+
+  allowNewSensors = true;
+  sendSportPacket(0x22, 0x0200, 100);
+  allowNewSensors = false;
+  EXPECT_EQ(g_model.telemetrySensors[0].id, 0x0200);
+  EXPECT_EQ(telemetryItems[0].value, 100);
+
+  // new label
+  strncpy(g_model.telemetrySensors[0].label, "Amps", TELEM_LABEL_LEN);
+  storageDirty(EE_MODEL);
+  sendSportPacket(0x22, 0x0200, 200);
+  EXPECT_EQ(telemetryItems[0].value, 200);
+
+  // new id: the sensor doesn't get the values of the former id
+  g_model.telemetrySensors[0].id = 0x0201;
+  storageDirty(EE_MODEL);
+  sendSportPacket(0x22, 0x0200, 300);
+  EXPECT_EQ(telemetryItems[0].value, 200);
+  sendSportPacket(0x22, 0x0201, 400);
+  EXPECT_EQ(telemetryItems[0].value, 400);
+}
+
+TEST(FrSkySPORT, sensorsIndexDelete)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+
+  allowNewSensors = true;
+  sendSportPacket(0x22, 0x0200, 100);
+  sendSportPacket(0x22, 0x0210, 1200);
+  allowNewSensors = false;
+  EXPECT_EQ(telemetryItems[0].value, 100);
+
+  delTelemetryIndex(0);
+  sendSportPacket(0x22, 0x0200, 200);
+  EXPECT_FALSE(g_model.telemetrySensors[0].isAvailable());
+  EXPECT_EQ(telemetryItems[0].value, 0);
+
+  // discovered again in the free slot
+  allowNewSensors = true;
+  sendSportPacket(0x22, 0x0200, 300);
+  allowNewSensors = false;
+  EXPECT_EQ(g_model.telemetrySensors[0].id, 0x0200);
+  EXPECT_EQ(telemetryItems[0].value, 300);
+}
+
+TEST(FrSkySPORT, sensorsIndexReorder)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+
+  allowNewSensors = true;
+  sendSportPacket(0x22, 0x0200, 100);
+  sendSportPacket(0x22, 0x0210, 1200);
+  allowNewSensors = false;
+  EXPECT_EQ(g_model.telemetrySensors[0].id, 0x0200);
+  EXPECT_EQ(g_model.telemetrySensors[1].id, 0x0210);
+
+  std::swap(g_model.telemetrySensors[0], g_model.telemetrySensors[1]);
+  telemetryItems[0].clear();
+  telemetryItems[1].clear();
+  storageDirty(EE_MODEL);
+
+  sendSportPacket(0x22, 0x0200, 200);
+  EXPECT_EQ(telemetryItems[1].value, 200);
+  EXPECT_EQ(telemetryItems[0].value, 0);
+}
+
+TEST(FrSkySPORT, sensorsIndexIgnoreSensorIds)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+
+  // the same sensor on two physical ids
+  allowNewSensors = true;
+  sendSportPacket(0x22, 0x0200, 100);
+  sendSportPacket(0x23, 0x0200, 50);
+  allowNewSensors = false;
+  EXPECT_EQ(telemetryItems[0].value, 100);
+  EXPECT_EQ(telemetryItems[1].value, 50);
+
+  g_model.ignoreSensorIds = 1;
+  storageDirty(EE_MODEL);
+  sendSportPacket(0x22, 0x0200, 150);
+  EXPECT_EQ(telemetryItems[0].value, 150);
+  EXPECT_EQ(telemetryItems[1].value, 150);
+
+  g_model.ignoreSensorIds = 0;
+  storageDirty(EE_MODEL);
+  sendSportPacket(0x23, 0x0200, 70);
+  EXPECT_EQ(telemetryItems[0].value, 150);
+  EXPECT_EQ(telemetryItems[1].value, 70);
+}
+
+// S.Port frames of a receiver with a long sensors chain:
+// physical id, data id, value
+static const struct {
+  uint8_t physId;
+  uint16_t dataId;
+  uint32_t data;
+} sportSensorsChain[] = {
+  {0x98, 0xF101, 80},  {0x98, 0xF104, 162},   {0x98, 0xF105, 90},
+  {0x00, 0x0100, 1250}, {0x00, 0x0110, 0xFFFFFFDD},
+  {0xA1, 0x0300, 0x68D68D20}, {0xA1, 0x0300, 0x00068D22},
+  {0x22, 0x0200, 125},  {0x22, 0x0210, 1215},
+  {0x83, 0x0800, 0x40A9F3B0}, {0x83, 0x0800, 0x80D35B20},
+  {0x83, 0x0820, 12400}, {0x83, 0x0830, 23100}, {0x83, 0x0840, 18000},
+  {0x83, 0x0850, 0x15102001}, {0x83, 0x0850, 0x12300000},
+  {0xE4, 0x0400, 45},   {0xE4, 0x0410, 62},   {0xE4, 0x0500, 1800},
+  {0x45, 0x0600, 74},   {0x45, 0x0700, 12},   {0x45, 0x0710, 0xFFFFFFF8},
+  {0x45, 0x0720, 1005}, {0xC6, 0x0A00, 3301}, {0xC6, 0x0A10, 21},
+  {0x67, 0x0B00, 1180}, {0x67, 0x0B10, 960},  {0x67, 0x0B20, 0x12},
+  {0x48, 0x0B30, 55},   {0x48, 0x0B40, 4210}, {0x48, 0x0B50, 40},
+  {0xE9, 0x0B60, 33},   {0xE9, 0x0E50, 1210}, {0xE9, 0x0E60, 87},
+  {0x6A, 0x5100, 12},   {0x6A, 0x5110, 1000}, {0x6A, 0x5120, 640},
+  {0xCB, 0x0101, 1240}, {0xCB, 0x0111, 30},   {0xCB, 0x0211, 1190},
+};
+
+// Not a functional test: run it with
+// gtests-radio --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(FrSkySPORT, DISABLED_SensorsLookupBenchmark)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+
+  const unsigned count = DIM(sportSensorsChain);
+  uint8_t packets[count][FRSKY_SPORT_PACKET_SIZE];
+  for (unsigned i = 0; i < count; i++) {
+    uint8_t * packet = packets[i];
+    packet[0] = sportSensorsChain[i].physId;
+    packet[1] = 0x10; // DATA_FRAME
+    *((uint16_t *)(packet + 2)) = sportSensorsChain[i].dataId;
+    *((uint32_t *)(packet + 4)) = sportSensorsChain[i].data;
+    setSportPacketCrc(packet);
+  }
+
+  // discover the sensors, then fill the remaining slots
+  allowNewSensors = true;
+  for (auto & packet : packets) {
+    sportProcessTelemetryPacket(0, packet, sizeof(packet));
+  }
+  allowNewSensors = false;
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (!g_model.telemetrySensors[i].isAvailable()) {
+      g_model.telemetrySensors[i].type = TELEM_TYPE_CALCULATED;
+      g_model.telemetrySensors[i].formula = TELEM_FORMULA_ADD;
+    }
+  }
+
+  const int loops = 20000;
+
+  // with the former scan of all sensors for each value
+  telemetrySensorsLinearScan = true;
+  auto start = std::chrono::steady_clock::now();
+  for (int loop = 0; loop < loops; loop++) {
+    for (auto & packet : packets) {
+      sportProcessTelemetryPacket(0, packet, sizeof(packet));
+    }
+  }
+  auto scan = std::chrono::steady_clock::now() - start;
+
+  telemetrySensorsLinearScan = false;
+  telemetrySensorsIndexInvalidate();
+  start = std::chrono::steady_clock::now();
+  for (int loop = 0; loop < loops; loop++) {
+    for (auto & packet : packets) {
+      sportProcessTelemetryPacket(0, packet, sizeof(packet));
+    }
+  }
+  auto indexed = std::chrono::steady_clock::now() - start;
+
+  printf("%u frames x %d: scan %lld us, indexed %lld us\n", count, loops,
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(scan).count(),
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(indexed).count());
+}
@@ -104,6 +104,7 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
   EXPECT_EQ(g_model.flightModeData[0].gvars[0], 8);
 
   g_model.customFn[0].all.val = 10;   // inc/dec value
+  storageDirty(EE_MODEL);
  
   simuSetSwitch(0, -1);  // SAdown
   evalFunctions(g_model.customFn, modelFunctionsContext);
@@ -121,6 +122,35 @@ TEST_F(SpecialFunctionsTest, GvarsInc)
   evalFunctions(g_model.customFn, modelFunctionsContext);
   EXPECT_EQ(g_model.flightModeData[0].gvars[0], 28);
 }
+
+TEST_F(SpecialFunctionsTest, GvarsFlightModesCache)
+{
+  g_model.flightModeData[0].gvars[0] = 10;
+  g_model.flightModeData[1].gvars[0] = GVAR_MAX + 1;  // FM1 uses FM0
+  g_model.flightModeData[2].gvars[0] = GVAR_MAX + 2;  // FM2 uses FM1
+  storageDirty(EE_MODEL);
+
+  EXPECT_EQ(10, getGVarValue(0, 0));
+  EXPECT_EQ(-10, getGVarValue(-1, 1));
+  EXPECT_EQ(10, getGVarValue(0, 2));
+  EXPECT_EQ(100, getGVarValuePrec1(0, 2));
+
+  // a GVAR written in FM2 is seen right away in all the flight modes
+  g_model.customFn[0].swtch = SWSRC_ON;
+  g_model.customFn[0].func = FUNC_ADJUST_GVAR;
+  g_model.customFn[0].all.mode = FUNC_ADJUST_GVAR_CONSTANT;
+  g_model.customFn[0].all.param = 0;  // GV1
+  g_model.customFn[0].all.val = 20;
+  g_model.customFn[0].active = true;
+
+  mixerCurrentFlightMode = 2;
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(20, g_model.flightModeData[0].gvars[0]);
+  EXPECT_EQ(20, getGVarValue(0, 1));
+  EXPECT_EQ(20, getGVarValue(0, 2));
+
+  mixerCurrentFlightMode = 0;
+}
 #endif // #if defined(GVARS)
 
 #endif // #if defined(PCBFRSKY)
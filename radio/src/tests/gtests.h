@@ -31,6 +31,7 @@
 #include "model_init.h"
 #include "switches.h"
 #include "hal/switch_driver.h"
+#include "mixer_plan.h"
 
 #define CHANNEL_MAX (1024*256)
 
@@ -68,12 +69,16 @@ inline void SYSTEM_RESET()
 
 inline void MODEL_RESET()
 {
+  modelCachesAlwaysRebuild = false;
   memset(&g_model, 0, sizeof(g_model));
   anaResetFiltered();
   extern uint8_t s_mixer_first_run_done;
   s_mixer_first_run_done = false;
   evalMixes(1);  // this is needed to reset fp_act
   lastFlightMode = 255;
+  // the tests modifying g_model afterwards call storageDirty(EE_MODEL)
+  // before evaluating it again, as the menus do
+  modelCachesInvalidate();
 }
 
 inline void MIXER_RESET()
@@ -113,6 +118,7 @@ class OpenTxTest : public testing::Test
       MIXER_RESET();
       setModelDefaults();
       RADIO_RESET();
+      modelCachesInvalidate();
     }
 };
 
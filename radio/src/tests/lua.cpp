@@ -170,4 +170,55 @@ TEST(Lua, Switches)
   luaExecStr("if MIXSRC_SB == nil then error('failed') end");
 }
 
+TEST(Lua, setTelemetryValue)
+{
+  MODEL_RESET();
+  // the sensors index must follow the sensor created by Lua
+  allowNewSensors = true;
+  storageDirty(EE_MODEL);
+
+  luaExecStr("if not setTelemetryValue(0x5100, 0, 1, 10) then error('created') end");
+  luaExecStr("if setTelemetryValue(0x5100, 0, 1, 20) then error('duplicate') end");
+  EXPECT_EQ(1, getTelemetrySensorsCount());
+}
+
+TEST(Lua, getFieldId)
+{
+  MODEL_RESET();
+  // the fields cache must follow the model changes
+  g_model.telemetrySensors[0].init("Alt");
+  storageDirty(EE_MODEL);
+
+  luaExecStr("if getFieldId('ch1') ~= getFieldInfo('ch1').id then error('ch1') end");
+  luaExecStr("if getValue(getFieldId('max')) ~= 1024 then error('max') end");
+  luaExecStr("if getFieldId('Alt') ~= getFieldInfo('Alt').id then error('Alt') end");
+  luaExecStr("if getFieldId('Vfas') ~= nil then error('Vfas') end");
+  // same results from the cache
+  luaExecStr("if getFieldId('Alt+') ~= getFieldInfo('Alt+').id then error('Alt+') end");
+  luaExecStr("if getFieldId('Vfas') ~= nil then error('Vfas') end");
+
+  // renamed sensor
+  g_model.telemetrySensors[0].init("Vfas");
+  storageDirty(EE_MODEL);
+  luaExecStr("if getFieldId('Alt') ~= nil then error('Alt renamed') end");
+  luaExecStr("if getFieldId('Vfas') ~= getFieldInfo('Vfas').id then error('Vfas renamed') end");
+}
+
+TEST(Lua, getValues)
+{
+  MODEL_RESET();
+  luaExecStr(
+      "local ids = {getFieldId('max'), 'max', 'unknown'}\n"
+      "local values, current = {}, {}\n"
+      "if getValues(ids, values, current) ~= 3 then error('count') end\n"
+      "if values[1] ~= 1024 or values[2] ~= 1024 or values[3] ~= 0 then error('values') end\n"
+      "if not current[1] or not current[3] then error('current') end\n"
+      "collectgarbage('stop')\n"
+      "local used = collectgarbage('count')\n"
+      "for i = 1, 100 do getValues(ids, values, current) end\n"
+      "local garbage = collectgarbage('count') - used\n"
+      "collectgarbage('restart')\n"
+      "if garbage ~= 0 then error('garbage') end");
+}
+
 #endif   // #if defined(LUA)
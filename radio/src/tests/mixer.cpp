@@ -80,6 +80,7 @@ TEST_F(MixerTest, throttleInvert)
   // Mode 1 / reversed
   g_eeGeneral.stickMode = 0;
   g_model.throttleReversed = 1;
+  storageDirty(EE_MODEL);
   anaSetFiltered(inputMappingConvertMode(THR_STICK), -1024);
   evalMixes(1);
   EXPECT_EQ(channelOutputs[2], +1024);
@@ -87,6 +88,7 @@ TEST_F(MixerTest, throttleInvert)
   // Mode 2 / reversed
   g_eeGeneral.stickMode = 1;
   g_model.throttleReversed = 1;
+  storageDirty(EE_MODEL);
   anaSetFiltered(inputMappingConvertMode(THR_STICK), -1024);
   evalMixes(1);
   EXPECT_EQ(channelOutputs[2], +1024);
@@ -94,6 +96,7 @@ TEST_F(MixerTest, throttleInvert)
   // Mode 2 / normal
   g_eeGeneral.stickMode = 1;
   g_model.throttleReversed = 0;
+  storageDirty(EE_MODEL);
   anaSetFiltered(inputMappingConvertMode(THR_STICK), -1024);
   evalMixes(1);
   EXPECT_EQ(channelOutputs[2], -1024);
@@ -130,6 +133,7 @@ TEST_F(TrimsTest, throttleTrim)
 
   // now the same tests with extended Trims
   g_model.extendedTrims = 1;
+  storageDirty(EE_MODEL);
   // stick max + trim max
   anaSetFiltered(THR_STICK,  +1024);
   setTrimValue(0, THR_STICK, TRIM_EXTENDED_MAX);
@@ -161,6 +165,7 @@ TEST_F(TrimsTest, throttleTrim)
 TEST_F(TrimsTest, invertedThrottlePlusThrottleTrim)
 {
   g_model.throttleReversed = 1;
+  storageDirty(EE_MODEL);
   g_model.thrTrim = 1;
   // stick max + trim max
   anaSetFiltered(THR_STICK,  +1024);
@@ -190,6 +195,7 @@ TEST_F(TrimsTest, invertedThrottlePlusThrottleTrim)
 
   // now the same tests with extended Trims
   g_model.extendedTrims = 1;
+  storageDirty(EE_MODEL);
   // stick max + trim max
   anaSetFiltered(THR_STICK,  +1024);
   setTrimValue(0, THR_STICK, TRIM_EXTENDED_MAX);
@@ -256,6 +262,7 @@ TEST_F(TrimsTest, throttleTrimWithZeroWeightOnThrottle)
 
   // now some tests with extended Trims
   g_model.extendedTrims = 1;
+  storageDirty(EE_MODEL);
   // trim min + various stick positions = should always be same value
   setTrimValue(0, THR_STICK, TRIM_EXTENDED_MIN);
   anaSetFiltered(THR_STICK,  -1024);
@@ -290,6 +297,7 @@ TEST_F(TrimsTest, throttleTrimWithZeroWeightOnThrottle)
 TEST_F(TrimsTest, invertedThrottlePlusthrottleTrimWithZeroWeightOnThrottle)
 {
   g_model.throttleReversed = 1;
+  storageDirty(EE_MODEL);
   g_model.thrTrim = 1;
   // the input already exists
   ExpoData *expo = expoAddress(THR_STICK);
@@ -327,6 +335,7 @@ TEST_F(TrimsTest, invertedThrottlePlusthrottleTrimWithZeroWeightOnThrottle)
 
   // now some tests with extended Trims
   g_model.extendedTrims = 1;
+  storageDirty(EE_MODEL);
   // trim min + various stick positions = should always be same value
   setTrimValue(0, THR_STICK, TRIM_EXTENDED_MIN);
   anaSetFiltered(THR_STICK,  -1024);
@@ -524,6 +533,52 @@ TEST(Curves, LinearIntpol)
   EXPECT_EQ(applyCustomCurve(-192, 0), -192);
 }
 
+TEST(Curves, SmoothCurvesCache)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+
+  // 5 points
+  const int8_t curve0[] = {-100, -20, 0, 60, 100};
+  // 17 points, with local extrema
+  const int8_t curve1[] = {-100, 80, -60, 40, -20, 0, 100, 100, 50,
+                           -50, 20, 30, -100, 90, 10, -10, 0};
+  // 6 points custom, with irregular X
+  const int8_t curve2[] = {100, -100, 0, 90, -30, 40, -60, -55, 10, 80};
+
+  g_model.curves[0].smooth = 1;
+  g_model.curves[1].smooth = 1;
+  g_model.curves[1].points = 12;
+  g_model.curves[2].smooth = 1;
+  g_model.curves[2].type = CURVE_TYPE_CUSTOM;
+  g_model.curves[2].points = 1;
+  loadCurves();
+  memcpy(curveAddress(0), curve0, sizeof(curve0));
+  memcpy(curveAddress(1), curve1, sizeof(curve1));
+  memcpy(curveAddress(2), curve2, sizeof(curve2));
+
+  // reference values, computed without the cache
+  static int ref[3][2 * RESX + 201];
+  for (int idx = 0; idx < 3; idx++) {
+    EXPECT_FALSE(isCurveCached(idx));
+    for (int x = -RESX - 100; x <= RESX + 100; x++)
+      ref[idx][x + RESX + 100] = applyCustomCurve(x, idx);
+  }
+
+  curvesCacheUpdate();
+  for (int idx = 0; idx < 3; idx++) {
+    EXPECT_TRUE(isCurveCached(idx));
+    for (int x = -RESX - 100; x <= RESX + 100; x++)
+      EXPECT_EQ(applyCustomCurve(x, idx), ref[idx][x + RESX + 100]);
+  }
+  EXPECT_FALSE(isCurveCached(3));
+
+  curvesCacheInvalidate();
+  EXPECT_FALSE(isCurveCached(0));
+}
+
 
 
 TEST_F(MixerTest, InfiniteRecursiveChannels)
@@ -543,6 +598,106 @@ TEST_F(MixerTest, InfiniteRecursiveChannels)
   EXPECT_EQ(chans[0], 0);
 }
 
+TEST_F(MixerTest, ChannelsInDependencyOrder)
+{
+  // CH1 <- CH2 <- CH3, computed in a single pass
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH + 2;
+  g_model.mixData[1].weight = 50;
+  g_model.mixData[2].destCh = 2;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].weight = 100;
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[2], CHANNEL_MAX);
+  EXPECT_EQ(chans[1], CHANNEL_MAX/2);
+  EXPECT_EQ(chans[0], CHANNEL_MAX/2);
+  EXPECT_EQ(mixerGetLoopChannels(), 0u);
+}
+
+TEST_F(MixerTest, LoopChannelsDetection)
+{
+  // CH1 <-> CH2 loop, CH3 depends on the loop
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_MAX;
+  g_model.mixData[1].weight = 50;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[2].weight = 100;
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[3].weight = 100;
+
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(mixerPlanGet().loopChannels, 0b011u);
+  EXPECT_EQ(mixerGetLoopChannels(), 0b011u);
+  EXPECT_TRUE(isMixLineInLoop(0));
+  EXPECT_FALSE(isMixLineInLoop(1));
+  EXPECT_TRUE(isMixLineInLoop(2));
+  EXPECT_FALSE(isMixLineInLoop(3));
+
+  // CH1 uses the previous value of CH2 (one cycle delay)
+  EXPECT_EQ(chans[0], 0);
+  EXPECT_EQ(chans[1], CHANNEL_MAX/2);
+  // CH3 is computed after the loop
+  EXPECT_EQ(chans[2], chans[0]);
+}
+
+TEST_F(MixerTest, SeparateLoops)
+{
+  // CH1 <-> CH2 and CH3 <-> CH4 loops, CH1 uses CH3
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_FIRST_CH + 1;
+  g_model.mixData[0].weight = 100;
+  g_model.mixData[1].destCh = 0;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH + 2;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[2].weight = 100;
+  g_model.mixData[3].destCh = 2;
+  g_model.mixData[3].srcRaw = MIXSRC_FIRST_CH + 3;
+  g_model.mixData[3].weight = 100;
+  g_model.mixData[4].destCh = 3;
+  g_model.mixData[4].srcRaw = MIXSRC_FIRST_CH + 2;
+  g_model.mixData[4].weight = 100;
+
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(mixerGetLoopChannels(), 0b1111u);
+  EXPECT_TRUE(isMixLineInLoop(0));
+  EXPECT_FALSE(isMixLineInLoop(1));
+  EXPECT_TRUE(isMixLineInLoop(2));
+  EXPECT_TRUE(isMixLineInLoop(3));
+  EXPECT_TRUE(isMixLineInLoop(4));
+}
+
+#if !defined(COLORLCD)
+TEST_F(MixerTest, PlanRebuiltAfterEdit)
+{
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 0;
+  storageDirty(EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_EQ(chans[0], 0);
+
+  // the weight is edited in the menus, the mixer runs before it is written
+  int weight = checkIncDec(EVT_KEY_BREAK(KEY_ENTER), g_model.mixData[0].weight,
+                           0, 1, EE_MODEL);
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  g_model.mixData[0].weight = weight;
+  checkModelCaches();
+
+  evalFlightModeMixes(e_perout_mode_normal, 0);
+  EXPECT_GT(chans[0], 0);
+}
+#endif
+
 TEST_F(MixerTest, BlockingChannel)
 {
   g_model.mixData[0].destCh = 0;
@@ -879,6 +1034,36 @@ TEST_F(MixerTest, flightModeTransition)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, -102);
 }
 
+TEST_F(MixerTest, flightModeTransitionSharedLines)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+  setModelDefaults();
+  g_model.flightModeData[1].swtch = SWSRC_FIRST_SWITCH + 2;
+  g_model.flightModeData[0].fadeIn = 100;
+  g_model.flightModeData[0].fadeOut = 100;
+  g_model.flightModeData[1].fadeIn = 100;
+  g_model.flightModeData[1].fadeOut = 100;
+  // CH1 and the first line of CH2 are the same in all flight modes
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = 50;
+  g_model.mixData[1].destCh = 1;
+  g_model.mixData[1].srcRaw = MIXSRC_FIRST_CH;
+  g_model.mixData[1].weight = 100;
+  g_model.mixData[2].destCh = 1;
+  g_model.mixData[2].srcRaw = MIXSRC_MAX;
+  g_model.mixData[2].flightModes = 0b11101;
+  g_model.mixData[2].weight = -10;
+  evalMixes(1);
+  EXPECT_EQ(channelOutputs[0], 512);
+  EXPECT_EQ(channelOutputs[1], 512);
+  simuSetSwitch(0, 1);
+  CHECK_FLIGHT_MODE_TRANSITION(1, 1000, 512, 512 - 102);
+  EXPECT_EQ(channelOutputs[0], 512);
+}
+
 TEST_F(MixerTest, flightModeOverflow)
 {
   SYSTEM_RESET();
@@ -943,6 +1128,7 @@ TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 
   // now the same tests with extended Trims
   g_model.extendedTrims = 1;
+  storageDirty(EE_MODEL);
   // stick max + trim max
   anaSetFiltered(THR_STICK,  +1024);
   setTrimValue(0, MIXSRC_TrimEle - MIXSRC_FIRST_TRIM, TRIM_EXTENDED_MAX);
@@ -978,6 +1164,7 @@ TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 TEST_F(TrimsTest, invertedThrottlePlusThrottleTrimWithCrossTrims)
 {
   g_model.throttleReversed = 1;
+  storageDirty(EE_MODEL);
   g_model.thrTrim = 1;
   g_model.thrTrimSw = MIXSRC_TrimEle - MIXSRC_FIRST_TRIM;
   ExpoData *expo = expoAddress(THR_STICK);
@@ -1019,6 +1206,7 @@ TEST_F(TrimsTest, invertedThrottlePlusThrottleTrimWithCrossTrims)
 
   // now the same tests with extended Trims
   g_model.extendedTrims = 1;
+  storageDirty(EE_MODEL);
   // stick max + trim max
   anaSetFiltered(THR_STICK,  +1024);
   setTrimValue(0, MIXSRC_TrimEle - MIXSRC_FIRST_TRIM, TRIM_EXTENDED_MAX);
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(STORAGE_MODELSLIST)
+
+#include "storage/modelslist.h"
+
+#define TEST_MODELS  150
+#define TEST_LABELS  10
+
+// Reference: model i has label j if this is true
+static bool hasLabel(int i, int j)
+{
+  return (i * 7 + j * 3) % 5 == 0 || (i % TEST_LABELS) == j;
+}
+
+static std::string labelName(int j)
+{
+  return "Label" + std::to_string(j);
+}
+
+class ModelsLabelsTest : public testing::Test
+{
+ protected:
+  ModelCell *models[TEST_MODELS];
+
+  void SetUp() override
+  {
+    modelslist.clear();
+    modelslabels.clear();
+    modelslabels.setSortOrder(NAME_ASC);
+
+    for (int j = 0; j < TEST_LABELS; j++) {
+      modelslabels.addLabel(labelName(j));
+    }
+
+    for (int i = 0; i < TEST_MODELS; i++) {
+      char name[LEN_MODEL_FILENAME + 1];
+      snprintf(name, sizeof(name), "model%03d.yml", i);
+      models[i] = new ModelCell(name);
+      snprintf(name, sizeof(name), "m%03d", i);
+      models[i]->setModelName(name);
+      modelslist.push_back(models[i]);
+      // the last models have no labels
+      if (i >= TEST_MODELS - 5) continue;
+      for (int j = 0; j < TEST_LABELS; j++) {
+        if (hasLabel(i, j))
+          EXPECT_FALSE(modelslabels.addLabelToModel(labelName(j), models[i]));
+      }
+    }
+  }
+
+  void TearDown() override
+  {
+    modelslabels.clear();
+    modelslist.clear();
+  }
+
+  bool modelHasLabel(int i, int j)
+  {
+    return i < TEST_MODELS - 5 && hasLabel(i, j);
+  }
+
+  // models are sorted by name, so by index
+  ModelsVector expected(std::function<bool(int)> filter)
+  {
+    ModelsVector rv;
+    for (int i = 0; i < TEST_MODELS; i++) {
+      if (filter(i)) rv.push_back(models[i]);
+    }
+    return rv;
+  }
+};
+
+TEST_F(ModelsLabelsTest, getModelsByLabel)
+{
+  for (int j = 0; j < TEST_LABELS; j++) {
+    EXPECT_EQ(expected([=](int i) { return modelHasLabel(i, j); }),
+              modelslabels.getModelsByLabel(labelName(j)));
+  }
+  EXPECT_EQ(ModelsVector(), modelslabels.getModelsByLabel("Unknown"));
+}
+
+TEST_F(ModelsLabelsTest, getModelsByLabels)
+{
+  LabelsVector lbls = {labelName(1), labelName(4)};
+  EXPECT_EQ(expected([=](int i) {
+              return modelHasLabel(i, 1) || modelHasLabel(i, 4);
+            }),
+            modelslabels.getModelsByLabels(lbls));
+
+  lbls.push_back(STR_UNLABELEDMODEL);
+  EXPECT_EQ(expected([=](int i) {
+              return modelHasLabel(i, 1) || modelHasLabel(i, 4) ||
+                     i >= TEST_MODELS - 5;
+            }),
+            modelslabels.getModelsByLabels(lbls));
+}
+
+TEST_F(ModelsLabelsTest, getModelsInLabels)
+{
+  LabelsVector lbls = {labelName(2), labelName(5)};
+  EXPECT_EQ(expected([=](int i) {
+              return modelHasLabel(i, 2) && modelHasLabel(i, 5);
+            }),
+            modelslabels.getModelsInLabels(lbls));
+
+  // unknown labels match no model
+  lbls.push_back("Unknown");
+  EXPECT_EQ(ModelsVector(), modelslabels.getModelsInLabels(lbls));
+
+  EXPECT_EQ(expected([=](int i) { return i >= TEST_MODELS - 5; }),
+            modelslabels.getModelsInLabels({STR_UNLABELEDMODEL}));
+  EXPECT_EQ(modelslabels.getUnlabeledModels(),
+            modelslabels.getModelsInLabels({STR_UNLABELEDMODEL}));
+}
+
+TEST_F(ModelsLabelsTest, getLabelsByModel)
+{
+  for (int i = 0; i < TEST_MODELS; i++) {
+    LabelsVector lbls;
+    for (int j = 0; j < TEST_LABELS; j++) {
+      if (modelHasLabel(i, j)) lbls.push_back(labelName(j));
+      EXPECT_EQ(modelHasLabel(i, j),
+                modelslabels.isLabelSelected(labelName(j), models[i]));
+      EXPECT_EQ(modelHasLabel(i, j),
+                modelslabels.getSelectedLabels(models[i])[labelName(j)]);
+    }
+    EXPECT_EQ(lbls, modelslabels.getLabelsByModel(models[i]));
+  }
+}
+
+TEST_F(ModelsLabelsTest, addRemoveLabel)
+{
+  int i = TEST_MODELS - 1;
+  EXPECT_TRUE(modelslabels.getLabelsByModel(models[i]).empty());
+
+  EXPECT_FALSE(modelslabels.addLabelToModel(labelName(3), models[i]));
+  EXPECT_TRUE(modelslabels.isLabelSelected(labelName(3), models[i]));
+  EXPECT_EQ(LabelsVector({labelName(3)}),
+            modelslabels.getLabelsByModel(models[i]));
+
+  EXPECT_FALSE(modelslabels.removeLabelFromModel(labelName(3), models[i]));
+  EXPECT_FALSE(modelslabels.isLabelSelected(labelName(3), models[i]));
+  EXPECT_TRUE(modelslabels.removeLabelFromModel(labelName(3), models[i]));
+}
+
+TEST_F(ModelsLabelsTest, manyLabels)
+{
+  // beyond the labels kept in place in the models masks
+  const int count = 150;
+  for (int j = TEST_LABELS; j < count; j++) {
+    EXPECT_EQ(j, modelslabels.addLabel(labelName(j)));
+  }
+  EXPECT_EQ(count, (int)modelslabels.getLabels().size());
+
+  int i = TEST_MODELS - 1;  // no labels
+  EXPECT_FALSE(modelslabels.addLabelToModel(labelName(100), models[i]));
+  EXPECT_FALSE(modelslabels.addLabelToModel(labelName(140), models[0]));
+  EXPECT_FALSE(modelslabels.addLabelToModel(labelName(100), models[0]));
+
+  EXPECT_EQ(ModelsVector({models[0], models[i]}),
+            modelslabels.getModelsByLabel(labelName(100)));
+  EXPECT_EQ(ModelsVector({models[0]}),
+            modelslabels.getModelsInLabels({labelName(100), labelName(140)}));
+  EXPECT_EQ(ModelsVector({models[0]}),
+            modelslabels.getModelsInLabels({labelName(0), labelName(140)}));
+  EXPECT_EQ(ModelsVector({models[0], models[i]}),
+            modelslabels.getModelsByLabels({labelName(100), labelName(140)}));
+  EXPECT_TRUE(modelslabels.isLabelSelected(labelName(140), models[0]));
+  EXPECT_EQ(LabelsVector({labelName(100)}),
+            modelslabels.getLabelsByModel(models[i]));
+
+  // a model with only such labels is not unlabeled
+  EXPECT_EQ(expected([=](int i) { return i >= TEST_MODELS - 5; }).size() - 1,
+            modelslabels.getUnlabeledModels().size());
+
+  EXPECT_FALSE(modelslabels.removeLabelFromModel(labelName(100), models[i]));
+  EXPECT_FALSE(modelslabels.isLabelSelected(labelName(100), models[i]));
+  EXPECT_EQ(ModelsVector({models[0]}),
+            modelslabels.getModelsByLabel(labelName(100)));
+}
+
+#endif
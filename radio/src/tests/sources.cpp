@@ -19,6 +19,8 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
+
 #include "gtests.h"
 
 #include "storage/yaml/yaml_tree_walker.h"
@@ -116,3 +118,87 @@ TEST(Sources, getSourceString)
   EXPECT_STREQ(getSourceString(MIXSRC_TrimEle), STR_CHAR_TRIM "Ele");
   EXPECT_STREQ(getSourceString(MIXSRC_TrimThr), STR_CHAR_TRIM "Thr");
 }
+
+TEST(Sources, resolveMixSource)
+{
+  struct {
+    mixsrc_t first;
+    mixsrc_t last;
+    uint8_t category;
+  } ranges[] = {
+    { MIXSRC_FIRST_INPUT, MIXSRC_LAST_INPUT, MIXSRC_CAT_INPUT },
+#if defined(LUA_INPUTS)
+    { MIXSRC_FIRST_LUA, MIXSRC_LAST_LUA, MIXSRC_CAT_LUA },
+#endif
+    { MIXSRC_FIRST_STICK, MIXSRC_LAST_STICK, MIXSRC_CAT_STICK },
+    { MIXSRC_FIRST_POT, MIXSRC_LAST_POT, MIXSRC_CAT_POT },
+#if defined(IMU)
+    { MIXSRC_TILT_X, MIXSRC_TILT_Y, MIXSRC_CAT_TILT },
+#endif
+#if defined(SPACEMOUSE)
+    { MIXSRC_FIRST_SPACEMOUSE, MIXSRC_LAST_SPACEMOUSE, MIXSRC_CAT_SPACEMOUSE },
+#endif
+    { MIXSRC_MIN, MIXSRC_MIN, MIXSRC_CAT_MIN },
+    { MIXSRC_MAX, MIXSRC_MAX, MIXSRC_CAT_MAX },
+    { MIXSRC_FIRST_HELI, MIXSRC_LAST_HELI, MIXSRC_CAT_HELI },
+    { MIXSRC_FIRST_TRIM, MIXSRC_LAST_TRIM, MIXSRC_CAT_TRIM },
+    { MIXSRC_FIRST_SWITCH, MIXSRC_LAST_SWITCH, MIXSRC_CAT_SWITCH },
+    { MIXSRC_FIRST_LOGICAL_SWITCH, MIXSRC_LAST_LOGICAL_SWITCH, MIXSRC_CAT_LOGICAL_SWITCH },
+    { MIXSRC_FIRST_TRAINER, MIXSRC_LAST_TRAINER, MIXSRC_CAT_TRAINER },
+    { MIXSRC_FIRST_CH, MIXSRC_LAST_CH, MIXSRC_CAT_CH },
+    { MIXSRC_FIRST_GVAR, MIXSRC_LAST_GVAR, MIXSRC_CAT_GVAR },
+    { MIXSRC_TX_VOLTAGE, MIXSRC_TX_VOLTAGE, MIXSRC_CAT_TX_VOLTAGE },
+    { MIXSRC_TX_TIME, MIXSRC_FIRST_TIMER - 1, MIXSRC_CAT_TX_TIME },
+    { MIXSRC_FIRST_TIMER, MIXSRC_LAST_TIMER, MIXSRC_CAT_TIMER },
+    { MIXSRC_FIRST_TELEM, MIXSRC_LAST_TELEM, MIXSRC_CAT_TELEM },
+  };
+
+  EXPECT_EQ(MIXSRC_CAT_NONE, resolveMixSource(MIXSRC_NONE).category);
+  EXPECT_EQ(MIXSRC_CAT_NONE, resolveMixSource(MIXSRC_LAST_TELEM + 1).category);
+
+  for (const auto& r : ranges) {
+    for (mixsrc_t i = r.first; i <= r.last; i++) {
+      MixSourceRef src = resolveMixSource(i);
+      EXPECT_EQ(r.category, src.category) << "source " << i;
+      EXPECT_EQ(i - r.first, src.index) << "source " << i;
+    }
+  }
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST(Sources, DISABLED_getValueBenchmark)
+{
+  const int loops = 20000;
+
+  for (uint8_t category = MIXSRC_CAT_INPUT; category <= MIXSRC_CAT_TELEM; category++) {
+    std::vector<mixsrc_t> sources;
+    std::vector<MixSourceRef> refs;
+    for (mixsrc_t i = MIXSRC_FIRST; i <= MIXSRC_LAST_TELEM; i++) {
+      if (resolveMixSource(i).category == category) {
+        sources.push_back(i);
+        refs.push_back(resolveMixSource(i));
+      }
+    }
+    if (sources.empty())
+      continue;
+
+    int64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < loops; n++) {
+      for (auto i : sources) sum += getValue(i);
+    }
+    auto bySource = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int n = 0; n < loops; n++) {
+      for (auto src : refs) sum -= getValue(src);
+    }
+    auto byRef = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(0, sum);
+    printf("category %2d (%3d sources): %6.1f ns by source, %6.1f ns resolved\n",
+           category, (int)sources.size(),
+           std::chrono::duration<double, std::nano>(bySource).count() / (loops * sources.size()),
+           std::chrono::duration<double, std::nano>(byRef).count() / (loops * sources.size()));
+  }
+}
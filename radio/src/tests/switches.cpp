@@ -25,6 +25,7 @@
 
 #include "hal/adc_driver.h"
 #include "hal/switch_driver.h"
+#include "lsw_plan.h"
 
 void setLogicalSwitch(int index, uint16_t _func, int16_t _v1, int16_t _v2, int16_t _v3 = 0, uint8_t _delay = 0, uint8_t _duration = 0, int8_t _andsw = 0)
 {
@@ -75,6 +76,73 @@ TEST(getSwitch, OldTypeStickyCSW)
 }
 #endif
 
+#if defined(PCBTARANIS)
+TEST(evalLogicalSwitches, forwardReference)
+{
+  RADIO_RESET();
+  MODEL_RESET();
+  MIXER_RESET();
+
+  // L1 uses L2, which is evaluated first
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_FIRST_SWITCH, SWSRC_NONE);
+
+  simuSetSwitch(0, 0);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+
+  // both switches change in the same cycle
+  simuSetSwitch(0, -1);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), true);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), true);
+
+  // a deleted logical switch is off
+  g_model.logicalSw[1].func = LS_FUNC_NONE;
+  storageDirty(EE_MODEL);
+  evalLogicalSwitches();
+  EXPECT_EQ(getSwitch(SWSRC_SW1), false);
+  EXPECT_EQ(getSwitch(SWSRC_SW2), false);
+}
+#endif
+
+TEST(evalLogicalSwitches, planOrder)
+{
+  MODEL_RESET();
+
+  // L1 uses the loop L3 <-> L4, which uses L2
+  setLogicalSwitch(0, LS_FUNC_AND, SWSRC_SW1 + 2, SWSRC_NONE);
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_ON, SWSRC_NONE);
+  setLogicalSwitch(2, LS_FUNC_OR, SWSRC_SW1 + 3, SWSRC_NONE);
+  setLogicalSwitch(3, LS_FUNC_OR, SWSRC_SW1 + 2, SWSRC_SW2);
+  // L5 unused, L6 independent
+  setLogicalSwitch(5, LS_FUNC_AND, SWSRC_ON, SWSRC_NONE);
+  // L7 compares the value of L8
+  setLogicalSwitch(6, LS_FUNC_VPOS, MIXSRC_FIRST_LOGICAL_SWITCH + 7, 0);
+  setLogicalSwitch(7, LS_FUNC_AND, SWSRC_ON, SWSRC_NONE);
+  storageDirty(EE_MODEL);
+
+  const LswPlan& plan = lswPlanGet();
+  const uint8_t order[] = { 1, 2, 3, 0, 5, 7, 6 };
+  ASSERT_EQ(DIM(order), plan.count);
+  for (unsigned i = 0; i < DIM(order); i++) {
+    EXPECT_EQ(order[i], plan.entries[i].idx);
+  }
+  EXPECT_EQ(MIXSRC_CAT_LOGICAL_SWITCH, plan.entries[6].v1.category);
+  EXPECT_EQ(7, plan.entries[6].v1.index);
+
+  // closing a loop through L1
+  setLogicalSwitch(1, LS_FUNC_AND, SWSRC_SW1, SWSRC_NONE);
+  storageDirty(EE_MODEL);
+
+  const uint8_t loopOrder[] = { 0, 1, 2, 3, 5, 7, 6 };
+  ASSERT_EQ(DIM(loopOrder), lswPlanGet().count);
+  for (unsigned i = 0; i < DIM(loopOrder); i++) {
+    EXPECT_EQ(loopOrder[i], plan.entries[i].idx);
+  }
+}
+
 TEST(getSwitch, nullSW)
 {
   MODEL_RESET();
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <vector>
+
+#include "gtests.h"
+#include "hal/module_port.h"
+#include "telemetry/spektrum.h"
+
+#if defined(GHOST)
+#include "pulses/ghost.h"
+#include "telemetry/ghost.h"
+#endif
+
+// The spans parsers must give the same result as the byte per byte ones,
+// wherever the spans end (the serial drivers return what they received).
+
+typedef std::vector<int32_t> TelemetryState;
+
+static TelemetryState getTelemetryState(const uint8_t* buffer, uint8_t len)
+{
+  TelemetryState state(buffer, buffer + len);
+  state.push_back(len);
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    state.push_back(g_model.telemetrySensors[i].id);
+    state.push_back(g_model.telemetrySensors[i].instance);
+    state.push_back(telemetryItems[i].value);
+  }
+  return state;
+}
+
+// Parses the stream by spans of the given sizes (repeated), and returns
+// the parser and sensors state after each span
+template <class F>
+static std::vector<TelemetryState> parseStream(
+    const std::vector<uint8_t>& stream, const std::vector<uint32_t>& spans,
+    uint8_t* buffer, uint8_t& len, F parse)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  allowNewSensors = true;
+  len = 0;
+
+  std::vector<TelemetryState> states;
+  uint32_t pos = 0;
+  for (uint32_t i = 0; pos < stream.size(); i++) {
+    uint32_t size = std::min<uint32_t>(spans[i % spans.size()],
+                                       stream.size() - pos);
+    parse(&stream[pos], size);
+    pos += size;
+    states.push_back(getTelemetryState(buffer, len));
+  }
+  return states;
+}
+
+static const std::vector<std::vector<uint32_t>> testSpans = {
+  { 1 }, { 2 }, { 3, 7 }, { 13, 1, 31, 5 }, { 64, 17 }, { 1000 },
+};
+
+#if defined(GHOST)
+static void appendGhostPackStat(std::vector<uint8_t>& stream, uint16_t volts)
+{
+  uint8_t frame[] = {
+    GHST_ADDR_RADIO, 12, GHST_DL_PACK_STAT,
+    (uint8_t)volts, (uint8_t)(volts >> 8),  // volts
+    (uint8_t)(volts / 10), 0,               // amps
+    (uint8_t)(volts / 100), 0,              // mAh
+    0, 0, 0, 0, 0,
+  };
+  frame[13] = crc8(&frame[2], 11);
+  stream.insert(stream.end(), frame, frame + sizeof(frame));
+}
+
+TEST(Ghost, processBuffer)
+{
+  std::vector<uint8_t> stream = { 0x00, 0x55, 0xFF, 0x81, 0x12 };
+  for (uint16_t i = 0; i < 10; i++) {
+    appendGhostPackStat(stream, 1100 + i);
+    if (i == 3) {
+      // garbage between the frames
+      stream.insert(stream.end(), { 0x23, 0x7E, 0x00 });
+    }
+  }
+  // a bad length byte: the following bytes are dropped until the buffer
+  // is full
+  stream.insert(stream.end(), { GHST_ADDR_RADIO, 0x01, 0x02 });
+  for (uint16_t i = 0; i < 20; i++) {
+    appendGhostPackStat(stream, 1200 + i);
+  }
+
+  auto mod_st = modulePortGetState(EXTERNAL_MODULE);
+  uint8_t buffer[TELEMETRY_RX_PACKET_SIZE];
+  uint8_t len;
+
+  for (const auto& spans : testSpans) {
+    auto expected = parseStream(
+        stream, spans, buffer, len, [&](const uint8_t* data, uint32_t size) {
+          for (uint32_t i = 0; i < size; i++)
+            GhostDriver.processData(mod_st, data[i], buffer, &len);
+        });
+    EXPECT_EQ(getTelemetrySensorsCount(), 3);
+
+    auto states = parseStream(
+        stream, spans, buffer, len, [&](const uint8_t* data, uint32_t size) {
+          GhostDriver.processBuffer(mod_st, data, size, buffer, &len);
+        });
+    EXPECT_EQ(states, expected);
+  }
+}
+#endif
+
+static void appendSpektrumVoltage(std::vector<uint8_t>& stream,
+                                  uint16_t volts)
+{
+  uint8_t packet[18] = {
+    0xAA, 0x40, 0x01, 0x00, (uint8_t)(volts >> 8), (uint8_t)volts,
+  };
+  stream.insert(stream.end(), packet, packet + sizeof(packet));
+}
+
+static void appendDSMBind(std::vector<uint8_t>& stream, uint8_t channels)
+{
+  uint8_t packet[12] = {
+    0xAA, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, channels, 0xB2,
+  };
+  stream.insert(stream.end(), packet, packet + sizeof(packet));
+}
+
+TEST(Spektrum, processBuffer)
+{
+  std::vector<uint8_t> stream = { 0x00, 0x55, 0xFF, 0x80, 0x12 };
+  for (uint16_t i = 0; i < 20; i++) {
+    appendSpektrumVoltage(stream, 1100 + i);
+    if (i % 7 == 3) {
+      appendDSMBind(stream, 6 + i % 7);
+      // garbage between the packets
+      stream.insert(stream.end(), { 0x23, 0x80, 0x00 });
+    }
+  }
+
+  uint8_t buffer[TELEMETRY_RX_PACKET_SIZE];
+  uint8_t len;
+
+  for (const auto& spans : testSpans) {
+    auto expected = parseStream(
+        stream, spans, buffer, len, [&](const uint8_t* data, uint32_t size) {
+          for (uint32_t i = 0; i < size; i++)
+            processSpektrumTelemetryData(EXTERNAL_MODULE, data[i], buffer,
+                                         len);
+        });
+    // RSSI, A1 and the bind packet
+    EXPECT_EQ(getTelemetrySensorsCount(), 3);
+
+    auto states = parseStream(
+        stream, spans, buffer, len, [&](const uint8_t* data, uint32_t size) {
+          processSpektrumTelemetryBuffer(EXTERNAL_MODULE, data, size, buffer,
+                                         len);
+        });
+    EXPECT_EQ(states, expected);
+  }
+}
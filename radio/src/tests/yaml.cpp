@@ -19,11 +19,15 @@
  * GNU General Public License for more details.
  */
 
+#include <chrono>
+
 #include "gtests.h"
+#include "location.h"
 
 #include <storage/yaml/yaml_node.h>
 #include <storage/yaml/yaml_parser.h>
 #include <storage/yaml/yaml_tree_walker.h>
+#include <storage/yaml/yaml_datastructs.h>
 
 struct TestStruct {
   uint8_t foo;
@@ -68,3 +72,190 @@ TEST(Yaml, SkipBlankLines)
   EXPECT_EQ(YamlParser::CONTINUE_PARSING, yp.parse(chunk_3, sizeof(chunk_3) - 1));
   EXPECT_EQ(45, t.foo);
 }
+
+TEST(Yaml, KeysOrder)
+{
+  TestStruct t;
+
+  YamlTreeWalker tree;
+  tree.reset(&_root_node, (uint8_t*)&t);
+
+  // keys in the reverse order, unknown and repeated keys
+  const char str[] =
+      "testStruct:\n  bar: 34\n  foo: 12\n  baz: 56\n  bar: 78\n";
+
+  YamlParser yp;
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+  yp.parse(str, sizeof(str) - 1);
+  EXPECT_EQ(12, t.foo);
+  EXPECT_EQ(78, t.bar);
+}
+
+struct TestUnionStruct {
+  uint8_t first;
+  union {
+    uint8_t alpha;
+    int8_t beta;
+  };
+  uint8_t last;
+
+  TestUnionStruct() : first(0), alpha(0), last(0) {}
+};
+
+static uint8_t select_test_union(void*, uint8_t*, uint32_t)
+{
+  return 0;
+}
+
+static const struct YamlNode union_TestUnionStruct[] = {
+  YAML_UNSIGNED( "alpha", 8 ),
+  YAML_SIGNED( "beta", 8 ),
+  YAML_END
+};
+
+static const struct YamlNode struct_TestUnionStruct[] = {
+  YAML_UNSIGNED( "first", 8 ),
+  YAML_UNION( "", 8, union_TestUnionStruct, select_test_union ),
+  YAML_UNSIGNED( "last", 8 ),
+  YAML_END
+};
+
+static const struct YamlNode struct_union_test[] = {
+  YAML_STRUCT("testUnion", sizeof(TestUnionStruct) * 8, struct_TestUnionStruct, NULL),
+  YAML_END
+};
+
+static const struct YamlNode _union_root_node = YAML_ROOT( struct_union_test );
+
+TEST(Yaml, KeysOrderAnonymousUnion)
+{
+  TestUnionStruct t;
+
+  YamlTreeWalker tree;
+  tree.reset(&_union_root_node, (uint8_t*)&t);
+
+  // the key placed before the union comes after the union member
+  const char str[] =
+      "testUnion:\n  last: 56\n  alpha: 34\n  first: 12\n  last: 78\n";
+
+  YamlParser yp;
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+  yp.parse(str, sizeof(str) - 1);
+  EXPECT_EQ(12, t.first);
+  EXPECT_EQ(34, t.alpha);
+  EXPECT_EQ(78, t.last);
+
+  // and from a member to another member of the same union
+  tree.reset(&_union_root_node, (uint8_t*)&t);
+  const char str2[] = "testUnion:\n  alpha: 1\n  beta: -2\n  first: 3\n";
+  yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+  yp.set_eof();
+  yp.parse(str2, sizeof(str2) - 1);
+  EXPECT_EQ(3, t.first);
+  EXPECT_EQ(-2, t.beta);
+  EXPECT_EQ(78, t.last);
+}
+
+static bool yaml_string_writer(void* opaque, const char* str, size_t len)
+{
+  ((std::string*)opaque)->append(str, len);
+  return true;
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST(Yaml, DISABLED_ParseBenchmark)
+{
+  const int loops = 200;
+
+  // a model using all the mixes, inputs and logical switches
+  MODEL_RESET();
+  for (int i = 0; i < MAX_MIXERS; i++) {
+    MixData* mix = &g_model.mixData[i];
+    mix->destCh = i % MAX_OUTPUT_CHANNELS;
+    mix->srcRaw = MIXSRC_FIRST_STICK + (i % MAX_STICKS);
+    mix->weight = 100 - i;
+    mix->delayUp = i;
+    snprintf(mix->name, sizeof(mix->name), "mix%d", i);
+  }
+  for (int i = 0; i < MAX_EXPOS; i++) {
+    ExpoData* expo = &g_model.expoData[i];
+    expo->chn = i % MAX_INPUTS;
+    expo->mode = 3;
+    expo->srcRaw = MIXSRC_FIRST_STICK + (i % MAX_STICKS);
+    expo->weight = 100 - i;
+  }
+  for (int i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData* ls = &g_model.logicalSw[i];
+    ls->func = LS_FUNC_VPOS;
+    ls->v1 = MIXSRC_FIRST_STICK;
+    ls->v2 = i;
+    ls->delay = i;
+  }
+
+  std::string str;
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t*)&g_model);
+  EXPECT_TRUE(tree.generate(yaml_string_writer, &str));
+
+  MODEL_RESET();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    tree.reset(get_modeldata_nodes(), (uint8_t*)&g_model);
+    YamlParser yp;
+    yp.init(YamlTreeWalker::get_parser_calls(), &tree);
+    yp.set_eof();
+    yp.parse(str.c_str(), str.size());
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(100 - (MAX_MIXERS - 1), g_model.mixData[MAX_MIXERS - 1].weight);
+  EXPECT_EQ(MAX_MIXERS - 1, g_model.mixData[MAX_MIXERS - 1].delayUp);
+  EXPECT_EQ(100 - (MAX_EXPOS - 1), g_model.expoData[MAX_EXPOS - 1].weight);
+  EXPECT_EQ(MAX_LOGICAL_SWITCHES - 1,
+            g_model.logicalSw[MAX_LOGICAL_SWITCHES - 1].v2);
+
+  printf("model: %d bytes, %lld us\n", (int)str.size(),
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / loops);
+}
+
+#if defined(SDCARD_YAML)
+#include <storage/sdcard_yaml.h>
+
+// Run with --gtest_also_run_disabled_tests
+TEST(Yaml, DISABLED_LoadBenchmark)
+{
+  const int loops = 200;
+
+  simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+  sdCheckAndCreateDirectory(RADIO_PATH);
+  sdCheckAndCreateDirectory(MODELS_PATH);
+
+  RADIO_RESET();
+  MODEL_RESET();
+  EXPECT_EQ(nullptr, writeGeneralSettings());
+  EXPECT_EQ(nullptr, writeModelYaml("modelbench.yml"));
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    EXPECT_EQ(nullptr, loadRadioSettingsYaml(true));
+  }
+  auto radio = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < loops; i++) {
+    EXPECT_EQ(nullptr, readModelYaml("modelbench.yml", (uint8_t *)&g_model,
+                                     sizeof(g_model)));
+  }
+  auto model = std::chrono::steady_clock::now() - start;
+
+  printf("read buffer: %d bytes\n", YAML_READ_BUFFER_SIZE);
+  printf("radio.yml: %lld us\n",
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(radio).count() / loops);
+  printf("model: %lld us\n",
+         (long long)std::chrono::duration_cast<std::chrono::microseconds>(model).count() / loops);
+
+  simuFatfsSetPaths("", "");
+}
+#endif
@@ -273,6 +273,7 @@ const char STR_NODATA[] = TR_NODATA;
 const char STR_US[] = TR_US;
 const char STR_HZ[]  = TR_HZ;
 const char STR_TMIXMAXMS[] = TR_TMIXMAXMS;
+const char STR_TMIXFADEMAXMS[] = TR_TMIXFADEMAXMS;
 const char STR_FREE_STACK[] = TR_FREE_STACK;
 const char STR_INT_GPS_LABEL[]  = TR_INT_GPS_LABEL;
 const char STR_HEARTBEAT_LABEL[]  = TR_HEARTBEAT_LABEL;
@@ -417,6 +417,7 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "Tmix máx"
+#define TR_TMIXFADEMAXMS              "Tfade max"
 #define TR_FREE_STACK                 "Stack libre"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
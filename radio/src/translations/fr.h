@@ -433,6 +433,7 @@
 #define TR_HZ                          "Hz"
 
 #define TR_TMIXMAXMS                   "Tmix max"
+#define TR_TMIXFADEMAXMS               "Tfade max"
 #define TR_FREE_STACK                  "Pile libre"
 #define TR_INT_GPS_LABEL               "GPS interne"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
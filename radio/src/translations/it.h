@@ -425,6 +425,7 @@
 #define TR_US                           "us"
 #define TR_HZ                           "Hz"
 #define TR_TMIXMAXMS                    "Tmix max"
+#define TR_TMIXFADEMAXMS                "Tfade max"
 #define TR_FREE_STACK                   "Stack libero"
 #define TR_INT_GPS_LABEL                "GPS interno"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
@@ -424,6 +424,7 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "Tmix max"
+#define TR_TMIXFADEMAXMS              "Tfade max"
 #define TR_FREE_STACK                 "Free stack"
 #define TR_INT_GPS_LABEL               "Internal GPS"
 #define TR_HEARTBEAT_LABEL             "Heartbeat"
@@ -422,6 +422,7 @@
 #define TR_US                         "us"
 #define TR_HZ                         "Hz"
 #define TR_TMIXMAXMS                  "TmixMaks"
+#define TR_TMIXFADEMAXMS              "Tfade max"
 #define TR_FREE_STACK                 "Wolny stos"
 #define TR_INT_GPS_LABEL              "Wewnęt. GPS"
 #define TR_HEARTBEAT_LABEL            "Heartbeat"
@@ -427,6 +427,7 @@
 #define TR_US                          "US"
 #define TR_HZ                          "Hz"
 #define TR_TMIXMAXMS                   "Макс Tmix"
+#define TR_TMIXFADEMAXMS               "Tfade max"
 #define TR_FREE_STACK                  "Свободн стек"
 #define TR_INT_GPS_LABEL               "Внутренний GPS"
 #define TR_HEARTBEAT_LABEL             "Пульсация"
@@ -446,6 +446,7 @@
 #define TR_HZ                           "Hz"
 
 #define TR_TMIXMAXMS                    "Tmix max"
+#define TR_TMIXFADEMAXMS                "Tfade max"
 #define TR_FREE_STACK                   "Fri stack"
 #define TR_INT_GPS_LABEL                "Intern GPS"
 #define TR_HEARTBEAT_LABEL              "Heartbeat"
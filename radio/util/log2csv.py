@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""
+    This script converts a binary flight log (.elog, firmware built with
+    LOGS_BINARY=ON) into the CSV log written by the other firmwares.
+    The format is described in radio/src/logs_binary.h
+
+    Usage:
+
+        ./log2csv.py LOGS/model-2023-05-01-120000.elog [output.csv]
+"""
+
+import struct
+import sys
+from datetime import datetime, timezone
+
+MAGIC = b"ETXL"
+VERSION = 1
+PREAMBLE = struct.Struct("<4sBBHHHH")
+
+LOGS_COLUMN_TIME = 0
+LOGS_COLUMN_RTC = 1
+LOGS_COLUMN_VALUE = 2
+LOGS_COLUMN_HEX = 3
+LOGS_COLUMN_GPS = 4
+LOGS_COLUMN_DATETIME = 5
+LOGS_COLUMN_TEXT = 6
+
+
+def formatValue(value, prec):
+    if prec == 0:
+        return "%d" % value
+    sign = "-" if value < 0 else ""
+    divisor = 10 ** prec
+    return "%s%d.%0*d" % (sign, abs(value) // divisor, prec, abs(value) % divisor)
+
+
+def formatCoord(value):
+    sign = "-" if value < 0 else ""
+    return "%s%d.%06d" % (sign, abs(value) // 1000000, abs(value) % 1000000)
+
+
+def readColumns(data):
+    magic, version, _, count, recordSize, headerSize, _ = PREAMBLE.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a binary log file")
+
+    columns = []
+    names = []
+    pos = PREAMBLE.size
+    for _ in range(count):
+        type, size, prec = struct.unpack_from("<BBB", data, pos)
+        nameEnd = data.index(b"\0", pos + 3)
+        unitEnd = data.index(b"\0", nameEnd + 1)
+        name = data[pos + 3:nameEnd].decode("latin-1")
+        unit = data[nameEnd + 1:unitEnd].decode("latin-1")
+        pos = unitEnd + 1
+        if type == LOGS_COLUMN_RTC:
+            names += ["Date", "Time"]
+        elif unit:
+            names.append("%s(%s)" % (name, unit))
+        else:
+            names.append(name)
+        columns.append((type, size, prec))
+
+    if pos != headerSize or sum(c[1] for c in columns) != recordSize:
+        raise ValueError("corrupted header")
+
+    return columns, names, headerSize, recordSize
+
+
+def formatColumn(data, pos, type, size, prec):
+    if type == LOGS_COLUMN_TIME:
+        return ["%d" % struct.unpack_from("<I", data, pos)]
+    if type == LOGS_COLUMN_RTC:
+        seconds, ms10 = struct.unpack_from("<IB", data, pos)
+        time = datetime.fromtimestamp(seconds, timezone.utc)
+        return [time.strftime("%Y-%m-%d"), time.strftime("%H:%M:%S") + ".%02d0" % ms10]
+    if type == LOGS_COLUMN_VALUE:
+        value = int.from_bytes(data[pos:pos + size], "little", signed=True)
+        return [formatValue(value, prec)]
+    if type == LOGS_COLUMN_HEX:
+        value = int.from_bytes(data[pos:pos + size], "little")
+        return ["0x%0*X" % (size * 2, value)]
+    if type == LOGS_COLUMN_GPS:
+        latitude, longitude = struct.unpack_from("<ii", data, pos)
+        if latitude and longitude:
+            return [formatCoord(latitude) + " " + formatCoord(longitude)]
+        return [""]
+    if type == LOGS_COLUMN_DATETIME:
+        return ["%4d-%02d-%02d %02d:%02d:%02d" % struct.unpack_from("<HBBBBB", data, pos)]
+    if type == LOGS_COLUMN_TEXT:
+        text = data[pos:pos + size].split(b"\0")[0]
+        return ['"%s"' % text.decode("latin-1")]
+    raise ValueError("unknown column type %d" % type)
+
+
+def convert(data, out):
+    columns, names, pos, recordSize = readColumns(data)
+    out.write(",".join(names) + "\n")
+    # an incomplete last record (radio switched off) is ignored
+    while pos + recordSize <= len(data):
+        row = []
+        for type, size, prec in columns:
+            row += formatColumn(data, pos, type, size, prec)
+            pos += size
+        out.write(",".join(row) + "\n")
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Usage: %s <log.elog> [output.csv]" % sys.argv[0], file=sys.stderr)
+        sys.exit(1)
+
+    with open(sys.argv[1], "rb") as f:
+        data = f.read()
+
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w", newline="") as out:
+            convert(data, out)
+    else:
+        convert(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()